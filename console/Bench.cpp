@@ -0,0 +1,683 @@
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <memory>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+#include "json.hpp"
+#include "AsyncEngine.h"
+#include "Bench.h"
+#include "Board.h"
+#include "Endgame.h"
+#include "Engine.h"
+#include "Mcts.h"
+#include "Network.h"
+#include "Patterns.h"
+#include "ProofSearch.h"
+#include "SharedData.h"
+#include "Snapshot.h"
+#include "SparseBoard.h"
+#include "Threats.h"
+using json = nlohmann::json;
+
+//   Google Benchmark:   ,     minTime .
+//         (, )
+// (setup)     ,     
+typedef std::function<uint64_t(uint64_t iterations)> BenchmarkBody;
+
+struct Benchmark {
+	std::string name;
+	BenchmarkBody body;
+	std::function<void()> setup;
+};
+
+struct BenchmarkResult {
+	std::string name;
+	uint64_t iterations;
+	double nsPerIteration;
+	double itemsPerSecond;
+};
+
+static volatile uint64_t benchmarkSink; //    
+
+static BenchmarkResult RunBenchmark(const Benchmark& benchmark, double minTime) {
+	uint64_t iterations = 1;
+	for (;;) {
+		auto start = std::chrono::steady_clock::now();
+		uint64_t items = benchmark.body(iterations);
+		double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+		if (seconds >= minTime || iterations >= (1ULL << 40)) {
+			BenchmarkResult result;
+			result.name = benchmark.name;
+			result.iterations = iterations;
+			result.nsPerIteration = seconds * 1e9 / iterations;
+			result.itemsPerSecond = items / seconds;
+			return result;
+		}
+
+		// ,   ,  ,      10   
+		double scale = seconds > 0 ? minTime * 1.4 / seconds : 10.0;
+		if (scale > 10.0)
+			scale = 10.0;
+		uint64_t next = (uint64_t)(iterations * scale);
+		iterations = next > iterations ? next : iterations + 1;
+	}
+}
+
+//      
+static void RandomPosition(Board& board, int size, int winLength, int stones, std::mt19937& rng) {
+	for (;;) {
+		InitBoard(board, size, winLength);
+		while (board.moveCount < stones) {
+			int moves[MAX_CELLS];
+			int count = GenerateMoves(board, moves);
+			MakeMove(board, moves[rng() % count]);
+			if (GetResult(board) != RESULT_NONE)
+				break;
+		}
+		if (GetResult(board) == RESULT_NONE)
+			return;
+	}
+}
+
+static void AddBoardBenchmarks(std::vector<Benchmark>& benchmarks) {
+	static const int sizes[] = { 3, 4, 5, 6, 7, 8, 9, 10, 15, 19 };
+	for (int size : sizes) {
+		int winLength = size < 5 ? size : 5;
+
+		benchmarks.push_back({ "MoveApplyUndo/" + std::to_string(size), [=](uint64_t iterations) {
+			std::mt19937 rng(size);
+			Board board;
+			RandomPosition(board, size, winLength, size * size / 3, rng);
+			int moves[MAX_CELLS];
+			int count = GenerateMoves(board, moves);
+			for (uint64_t i = 0; i < iterations; i++) {
+				MakeMove(board, moves[i % count]);
+				UndoMove(board);
+			}
+			benchmarkSink = board.hash;
+			return iterations;
+		} });
+
+		benchmarks.push_back({ "WinCheck/" + std::to_string(size), [=](uint64_t iterations) {
+			std::mt19937 rng(size);
+			Board board;
+			RandomPosition(board, size, winLength, size * size / 2, rng);
+			int moves[MAX_CELLS];
+			int count = GenerateMoves(board, moves);
+			uint64_t wins = 0;
+			for (uint64_t i = 0; i < iterations; i++)
+				wins += IsWinningMove(board, moves[i % count], board.sideToMove);
+			benchmarkSink = wins;
+			return iterations;
+		} });
+	}
+}
+
+//     :        ,    
+static void AddPatternBenchmarks(std::vector<Benchmark>& benchmarks) {
+	static const int sizes[] = { 6, 10, 15, 19 };
+	for (int size : sizes) {
+		int winLength = size < 10 ? 4 : 5;
+		benchmarks.push_back({ "PatternMoveUndo/" + std::to_string(size), [=](uint64_t iterations) {
+			std::mt19937 rng(size);
+			Board board;
+			RandomPosition(board, size, winLength, size * size / 3, rng);
+			PatternEval eval = {};
+			InitPatterns(eval, board);
+			int moves[MAX_CELLS];
+			int count = GenerateMoves(board, moves);
+			int64_t total = 0;
+			for (uint64_t i = 0; i < iterations; i++) {
+				PatternMove(eval, moves[i % count], board.sideToMove);
+				total += PatternScore(eval, board.sideToMove);
+				PatternUndo(eval, moves[i % count], board.sideToMove);
+			}
+			benchmarkSink = total;
+			return iterations;
+		} });
+	}
+}
+
+//       ,   ,    .
+//Refresh -        ,      
+static void AddNetworkBenchmarks(std::vector<Benchmark>& benchmarks) {
+	const int size = 15, winLength = 5;
+	std::shared_ptr<Network> network = std::make_shared<Network>();
+	auto setup = [network]() {
+		InitRandomNetwork(*network, size, winLength, 1);
+	};
+
+	for (int kernel = NETWORK_KERNEL_SCALAR; kernel <= DetectNetworkKernel(); kernel++) {
+		benchmarks.push_back({ std::string("NetworkEval/") + NetworkKernelName(kernel), [=](uint64_t iterations) {
+			network->kernel = kernel;
+			std::mt19937 rng(size);
+			Board board;
+			RandomPosition(board, size, winLength, size * size / 3, rng);
+			NetworkAccumulator accumulator;
+			InitAccumulator(accumulator, *network, board);
+			int moves[MAX_CELLS];
+			int count = GenerateMoves(board, moves);
+			int64_t total = 0;
+			for (uint64_t i = 0; i < iterations; i++) {
+				AccumulatorMove(accumulator, moves[i % count], board.sideToMove);
+				total += NetworkScore(accumulator, board.sideToMove ^ 1);
+				AccumulatorUndo(accumulator, moves[i % count], board.sideToMove);
+			}
+			benchmarkSink = total;
+			return iterations;
+		}, setup });
+	}
+
+	benchmarks.push_back({ "NetworkRefresh/" + std::to_string(size), [=](uint64_t iterations) {
+		network->kernel = DetectNetworkKernel();
+		std::mt19937 rng(size);
+		Board board;
+		RandomPosition(board, size, winLength, size * size / 3, rng);
+		NetworkAccumulator accumulator;
+		int64_t total = 0;
+		for (uint64_t i = 0; i < iterations; i++) {
+			InitAccumulator(accumulator, *network, board);
+			total += NetworkScore(accumulator, board.sideToMove);
+		}
+		benchmarkSink = total;
+		return iterations;
+	}, setup });
+}
+
+//  ,     19x19,         
+static void AddSparseBenchmarks(std::vector<Benchmark>& benchmarks) {
+	auto makePosition = [](SparseBoard& sparse, int stones) {
+		std::mt19937 rng(19);
+		Board board;
+		RandomPosition(board, 19, 5, stones, rng);
+		InitBoard(sparse, 5);
+		for (int i = 0; i < board.moveCount; i++)
+			MakeMove(sparse, SparseCell(board.moves[i] % 19 - 1000, board.moves[i] / 19 + 1000));
+	};
+
+	benchmarks.push_back({ "SparseMoveApplyUndo", [=](uint64_t iterations) {
+		SparseBoard board;
+		makePosition(board, 19 * 19 / 3);
+		std::vector<uint32_t> moves;
+		int count = GenerateMoves(board, moves);
+		for (uint64_t i = 0; i < iterations; i++) {
+			MakeMove(board, moves[i % count]);
+			UndoMove(board);
+		}
+		benchmarkSink = board.hash;
+		return iterations;
+	} });
+
+	benchmarks.push_back({ "SparseWinCheck", [=](uint64_t iterations) {
+		SparseBoard board;
+		makePosition(board, 19 * 19 / 2);
+		std::vector<uint32_t> moves;
+		int count = GenerateMoves(board, moves);
+		uint64_t wins = 0;
+		for (uint64_t i = 0; i < iterations; i++)
+			wins += IsWinningMove(board, moves[i % count], board.sideToMove);
+		benchmarkSink = wins;
+		return iterations;
+	} });
+
+	benchmarks.push_back({ "SparseGenerateMoves", [=](uint64_t iterations) {
+		SparseBoard board;
+		makePosition(board, 20);
+		std::vector<uint32_t> moves;
+		uint64_t total = 0;
+		for (uint64_t i = 0; i < iterations; i++)
+			total += GenerateMoves(board, moves);
+		benchmarkSink = total;
+		return total;
+	} });
+}
+
+static void AddSnapshotBenchmarks(std::vector<Benchmark>& benchmarks) {
+	//  ,     WM_UPDATE_BOARD:    
+	benchmarks.push_back({ "SharedDataCopy", [](uint64_t iterations) {
+		static SharedData shared, local;
+		memset(shared.board, '.', sizeof(shared.board));
+		for (uint64_t i = 0; i < iterations; i++) {
+			shared.board[i % MAX_GRID_SIZE][0] = (char)i;
+			local = shared;
+		}
+		benchmarkSink = local.board[0][0];
+		return iterations;
+	} });
+
+	benchmarks.push_back({ "SnapshotBuild", [](uint64_t iterations) {
+		static SharedData shared;
+		memset(&shared, 0, sizeof(shared));
+		memset(shared.board, '.', sizeof(shared.board));
+		for (int i = 0; i < MAX_CELLS / 2; i++) {
+			shared.board[i / MAX_GRID_SIZE][i % MAX_GRID_SIZE] = i % 2 ? 'O' : 'X';
+			shared.moves[shared.moveCount++] = PackMove(i, i % 2);
+		}
+		GameSnapshot snapshot;
+		uint64_t valid = 0;
+		for (uint64_t i = 0; i < iterations; i++) {
+			BuildSnapshot(shared, MAX_GRID_SIZE, snapshot);
+			valid += IsValidSnapshot(snapshot);
+		}
+		benchmarkSink = valid;
+		return iterations;
+	} });
+}
+
+//         ,   ,   -
+static void AddConfigBenchmarks(std::vector<Benchmark>& benchmarks) {
+	static const std::string settings = json({
+		{ "gridSize", 3 },
+		{ "winSize", { 489, 440 } },
+		{ "backColor", { 87, 73, 97 } },
+		{ "lineColor", { 128, 64, 128 } }
+	}).dump(4);
+
+	benchmarks.push_back({ "ConfigLoad", [](uint64_t iterations) {
+		uint64_t total = 0;
+		for (uint64_t i = 0; i < iterations; i++) {
+			json config = json::parse(settings);
+			if (config.contains("gridSize") && config["gridSize"].is_number_integer())
+				total += config["gridSize"].get<int>();
+			if (config.contains("winSize") && config["winSize"].is_array() && config["winSize"].size() == 2)
+				total += config["winSize"][0].get<int>();
+			if (config.contains("backColor") && config["backColor"].is_array() && config["backColor"].size() == 3)
+				total += config["backColor"][2].get<int>();
+			if (config.contains("lineColor") && config["lineColor"].is_array() && config["lineColor"].size() == 3)
+				total += config["lineColor"][2].get<int>();
+		}
+		benchmarkSink = total;
+		return iterations;
+	} });
+
+	benchmarks.push_back({ "ConfigSave", [](uint64_t iterations) {
+		uint64_t total = 0;
+		for (uint64_t i = 0; i < iterations; i++) {
+			json config = {
+				{ "gridSize", 3 },
+				{ "winSize", { 489, (int)(i & 255) } },
+				{ "backColor", { 87, 73, 97 } },
+				{ "lineColor", { 128, 64, 128 } }
+			};
+			total += config.dump(4).size();
+		}
+		benchmarkSink = total;
+		return iterations;
+	} });
+}
+
+//  -      ,  - .
+// ,       .     
+//:  3x3           ( - EndgameSolve)
+static void AddEngineBenchmarks(std::vector<Benchmark>& benchmarks) {
+	struct EngineCase {
+		int size, winLength, stones, depth;
+	};
+	static const EngineCase cases[] = { { 3, 3, 0, 9 }, { 4, 4, 2, 8 }, { 7, 4, 6, 4 }, { 10, 5, 8, 4 }, { 15, 5, 8, 3 }, { 19, 5, 8, 3 } };
+
+	for (const EngineCase& test : cases) {
+		std::shared_ptr<Engine> engine = std::make_shared<Engine>();
+		InitEngine(*engine, 1);
+		engine->threatSearch = false;
+		engine->solveEmpties = 0;
+		benchmarks.push_back({ "EngineSearch/" + std::to_string(test.size), [test, engine](uint64_t iterations) {
+			std::mt19937 rng(test.size);
+			Board board;
+			RandomPosition(board, test.size, test.winLength, test.stones, rng);
+
+			uint64_t nodes = 0;
+			SearchLimits limits = { test.depth, 0, 0, 0, 0 };
+			for (uint64_t i = 0; i < iterations; i++) {
+				ClearEngine(*engine);
+				nodes += Search(*engine, board, limits, NULL).nodes;
+			}
+			return nodes;
+		} });
+	}
+}
+
+const int MULTIPV_BENCH_LINES = 4;
+
+//    EngineSearch/15   :   ,    
+//      
+static void AddMultiPvBenchmarks(std::vector<Benchmark>& benchmarks) {
+	const int size = 15, winLength = 5, stones = 8, depth = 3;
+	std::shared_ptr<Engine> engine = std::make_shared<Engine>();
+	InitEngine(*engine, 1);
+	benchmarks.push_back({ "EngineMultiPv/" + std::to_string(size), [engine](uint64_t iterations) {
+		std::mt19937 rng(size);
+		Board board;
+		RandomPosition(board, size, winLength, stones, rng);
+
+		uint64_t nodes = 0;
+		SearchLimits limits = { depth, 0, 0, 0, MULTIPV_BENCH_LINES };
+		for (uint64_t i = 0; i < iterations; i++) {
+			ClearEngine(*engine);
+			nodes += Search(*engine, board, limits, NULL).nodes;
+		}
+		return nodes;
+	} });
+}
+
+//  :  -   ,    .
+//   ,       CancelSearch
+static void AddAsyncBenchmarks(std::vector<Benchmark>& benchmarks) {
+	const int size = 15, winLength = 5;
+	benchmarks.push_back({ "AsyncCancel/" + std::to_string(size), [=](uint64_t iterations) {
+		std::mt19937 rng(size);
+		Board board;
+		RandomPosition(board, size, winLength, 8, rng);
+
+		AsyncEngine async;
+		InitEngine(async.engine, 1);
+		async.engine.threatSearch = false;
+		StartAsyncEngine(async);
+		SearchLimits limits = { 0, 0, 0, 0, 0 };
+		for (uint64_t i = 0; i < iterations; i++) {
+			std::shared_ptr<std::promise<void>> started = std::make_shared<std::promise<void>>();
+			std::shared_ptr<std::promise<void>> finished = std::make_shared<std::promise<void>>();
+			std::future<void> startedFuture = started->get_future(), finishedFuture = finished->get_future();
+			bool first = true;
+			StartSearch(async, board, limits, [finished](const AsyncSearchDone&) {
+				finished->set_value();
+			}, [started, &first](const SearchInfo&) {
+				if (first)
+					started->set_value();
+				first = false;
+			});
+			startedFuture.wait();
+			CancelSearch(async);
+			finishedFuture.wait();
+		}
+		StopAsyncEngine(async);
+		return iterations;
+	} });
+}
+
+const uint64_t THREAT_BENCH_NODES = 5000; //    
+
+// :     ,     
+//  minPlies .     ,     
+struct TacticalPosition {
+	Board board;
+	int plies; // ,   
+};
+
+static std::vector<TacticalPosition> TacticalPositions(int size, int winLength, int count, int minPlies, int maxPlies) {
+	std::vector<TacticalPosition> positions;
+	std::mt19937 rng(size * 100 + winLength);
+	while ((int)positions.size() < count) {
+		Board board;
+		InitBoard(board, size, winLength);
+		while (GetResult(board) == RESULT_NONE) {
+			ThreatSearchResult threat = FindThreatWin(board, 12, THREAT_BENCH_NODES, true);
+			if (threat.win && threat.plies >= minPlies && threat.plies <= maxPlies) {
+				positions.push_back({ board, threat.plies });
+				break;
+			}
+			int moves[MAX_CELLS];
+			int moveCount = GenerateMoves(board, moves);
+			MakeMove(board, moves[rng() % moveCount]);
+		}
+	}
+	return positions;
+}
+
+//  :   -   ,  -  .
+//AlphaBeta        ,   
+static void AddThreatBenchmarks(std::vector<Benchmark>& benchmarks) {
+	struct ThreatCase {
+		int size, winLength;
+		bool alphaBeta; // 15x15   7   
+	};
+	static const ThreatCase cases[] = { { 6, 4, true }, { 10, 5, true }, { 15, 5, false } };
+
+	for (const ThreatCase& test : cases) {
+		//         ,  
+		std::shared_ptr<std::vector<TacticalPosition>> positions = std::make_shared<std::vector<TacticalPosition>>();
+		auto setup = [test, positions]() {
+			if (positions->empty())
+				*positions = TacticalPositions(test.size, test.winLength, 8, 5, 7);
+		};
+
+		benchmarks.push_back({ "ThreatSearch/" + std::to_string(test.size), [positions](uint64_t iterations) {
+			uint64_t solved = 0;
+			for (uint64_t i = 0; i < iterations; i++) {
+				for (const TacticalPosition& position : *positions)
+					solved += FindThreatWin(position.board, 12, THREAT_BENCH_NODES, true).win;
+			}
+			return solved;
+		}, setup });
+		if (!test.alphaBeta)
+			continue;
+
+		std::shared_ptr<Engine> engine = std::make_shared<Engine>();
+		InitEngine(*engine, 16);
+		engine->threatSearch = false;
+		benchmarks.push_back({ "ThreatAlphaBeta/" + std::to_string(test.size), [positions, engine](uint64_t iterations) {
+			uint64_t solved = 0;
+			for (uint64_t i = 0; i < iterations; i++) {
+				for (const TacticalPosition& position : *positions) {
+					ClearEngine(*engine);
+					SearchLimits limits = { position.plies, 0, 0, 0, 0 };
+					solved += Search(*engine, position.board, limits, NULL).score >= WIN_SCORE - MAX_PLY;
+				}
+			}
+			return solved;
+		}, setup });
+	}
+}
+
+const int PROOF_BENCH_TABLE_MB = 64;
+
+//       k = 4:   -     ,
+// - .    ,    
+static void AddProofBenchmarks(std::vector<Benchmark>& benchmarks) {
+	static const int sizes[] = { 4, 5, 6 };
+
+	for (int size : sizes) {
+		std::shared_ptr<ProofSolver> solver = std::make_shared<ProofSolver>();
+		auto setup = [solver]() {
+			if (solver->table.empty())
+				InitSolver(*solver, PROOF_BENCH_TABLE_MB);
+		};
+		benchmarks.push_back({ "ProofSolve/" + std::to_string(size), [size, solver](uint64_t iterations) {
+			Board board;
+			InitBoard(board, size, 4);
+			ProofLimits limits = { 0, 0, 0 };
+			uint64_t nodes = 0;
+			for (uint64_t i = 0; i < iterations; i++) {
+				ClearSolver(*solver);
+				ProofResult result = SolvePosition(*solver, board, limits, NULL);
+				benchmarkSink = result.result;
+				nodes += result.nodes;
+			}
+			return nodes;
+		}, setup });
+	}
+}
+
+const int ENDGAME_BENCH_POSITIONS = 8;
+
+//:   7x7  k = 4   ,    empties  .
+// -  ,     
+static std::vector<Board> EndgamePositions(int empties) {
+	const int size = 7, winLength = 4;
+	std::vector<Board> positions;
+	std::mt19937 rng(empties);
+	while ((int)positions.size() < ENDGAME_BENCH_POSITIONS) {
+		Board board;
+		InitBoard(board, size, winLength);
+		while (board.size * board.size - board.moveCount > empties) {
+			int moves[MAX_CELLS];
+			int moveCount = GenerateMoves(board, moves);
+			int count = 0;
+			for (int i = 0; i < moveCount; i++) {
+				if (!IsWinningMove(board, moves[i], board.sideToMove))
+					moves[count++] = moves[i];
+			}
+			if (count == 0)
+				break;
+			MakeMove(board, moves[rng() % count]);
+		}
+		if (board.size * board.size - board.moveCount != empties)
+			continue;
+
+		//       ,   
+		int moves[MAX_CELLS];
+		int moveCount = GenerateMoves(board, moves);
+		bool quiet = true;
+		for (int i = 0; i < moveCount && quiet; i++)
+			quiet = !IsWinningMove(board, moves[i], SIDE_X) && !IsWinningMove(board, moves[i], SIDE_O);
+		if (quiet)
+			positions.push_back(board);
+	}
+	return positions;
+}
+
+//       :   -  ,    ,
+// - .    DEFAULT_SOLVE_EMPTIES
+static void AddEndgameBenchmarks(std::vector<Benchmark>& benchmarks) {
+	static const int emptyCounts[] = { 8, 12, 16, 20 };
+
+	for (int empties : emptyCounts) {
+		std::shared_ptr<std::vector<Board>> positions = std::make_shared<std::vector<Board>>();
+		std::shared_ptr<EndgameSolver> solver = std::make_shared<EndgameSolver>();
+		auto setup = [empties, positions, solver]() {
+			if (positions->empty())
+				*positions = EndgamePositions(empties);
+			if (solver->table.empty())
+				InitEndgameSolver(*solver);
+		};
+		benchmarks.push_back({ "EndgameSolve/" + std::to_string(empties), [positions, solver](uint64_t iterations) {
+			uint64_t nodes = 0;
+			for (uint64_t i = 0; i < iterations; i++) {
+				std::fill(solver->table.begin(), solver->table.end(), EndgameEntry());
+				for (const Board& board : *positions) {
+					EndgameResult result = SolveEndgame(*solver, board, 0);
+					benchmarkSink = result.value;
+					nodes += result.nodes;
+				}
+			}
+			return nodes;
+		}, setup });
+	}
+}
+
+const uint64_t MCTS_BENCH_PLAYOUTS = 2000;
+const int MCTS_BENCH_LATENCY_US = 200;
+
+// MCTS        :   ,    
+static void AddMctsBenchmarks(std::vector<Benchmark>& benchmarks) {
+	const int size = 15, winLength = 5;
+	static const int batchSizes[] = { 1, 8, 32 };
+	std::shared_ptr<Network> network = std::make_shared<Network>();
+	auto setup = [network]() {
+		InitRandomNetwork(*network, size, winLength, 1);
+	};
+
+	for (int batchSize : batchSizes) {
+		benchmarks.push_back({ "MctsBatch/" + std::to_string(batchSize), [=](uint64_t iterations) {
+			std::mt19937 rng(size);
+			Board board;
+			RandomPosition(board, size, winLength, 10, rng);
+			MctsLimits limits = { MCTS_BENCH_PLAYOUTS, batchSize, 2 };
+			uint64_t playouts = 0;
+			for (uint64_t i = 0; i < iterations; i++) {
+				EvalQueue queue;
+				StartEvalQueue(queue, batchSize, batchSize, MCTS_BENCH_LATENCY_US, NetworkBatchEvaluator(*network));
+				playouts += SearchMcts(board, limits, queue).playouts;
+				StopEvalQueue(queue);
+			}
+			return playouts;
+		}, setup });
+	}
+}
+
+//   --benchmark_format=json  Google Benchmark,    compare.py  
+static void WriteJson(const std::vector<BenchmarkResult>& results, const std::string& path) {
+	json output;
+	output["context"] = {
+		{ "executable", "tic tac toe console" },
+		{ "num_cpus", std::thread::hardware_concurrency() },
+#ifdef NDEBUG
+		{ "library_build_type", "release" }
+#else
+		{ "library_build_type", "debug" }
+#endif
+	};
+	output["benchmarks"] = json::array();
+	for (const BenchmarkResult& result : results) {
+		output["benchmarks"].push_back({
+			{ "name", result.name },
+			{ "run_name", result.name },
+			{ "run_type", "iteration" },
+			{ "iterations", result.iterations },
+			{ "real_time", result.nsPerIteration },
+			{ "cpu_time", result.nsPerIteration },
+			{ "time_unit", "ns" },
+			{ "items_per_second", result.itemsPerSecond }
+		});
+	}
+
+	std::ofstream file(path);
+	file << output.dump(2) << "\n";
+}
+
+int BenchMain(int argc, char* argv[]) {
+	std::string jsonPath, filter;
+	double minTime = 0.5;
+	for (int i = 0; i + 1 < argc; i += 2) {
+		std::string key = argv[i];
+		if (key == "--json")
+			jsonPath = argv[i + 1];
+		else if (key == "--filter")
+			filter = argv[i + 1];
+		else if (key == "--min-time")
+			minTime = atof(argv[i + 1]);
+		else
+			argc = -1;
+	}
+	if (argc < 0 || argc % 2 != 0 || minTime <= 0) {
+		fprintf(stderr, ": bench [--filter ] [--min-time ] [--json ]\n");
+		return 1;
+	}
+
+	std::vector<Benchmark> benchmarks;
+	AddBoardBenchmarks(benchmarks);
+	AddPatternBenchmarks(benchmarks);
+	AddNetworkBenchmarks(benchmarks);
+	AddSparseBenchmarks(benchmarks);
+	AddSnapshotBenchmarks(benchmarks);
+	AddConfigBenchmarks(benchmarks);
+	AddEngineBenchmarks(benchmarks);
+	AddMultiPvBenchmarks(benchmarks);
+	AddAsyncBenchmarks(benchmarks);
+	AddThreatBenchmarks(benchmarks);
+	AddProofBenchmarks(benchmarks);
+	AddEndgameBenchmarks(benchmarks);
+	AddMctsBenchmarks(benchmarks);
+
+	std::vector<BenchmarkResult> results;
+	printf("%-24s %14s %14s %16s\n", "Benchmark", "Time ns", "Iterations", "Items/s");
+	for (const Benchmark& benchmark : benchmarks) {
+		if (!filter.empty() && benchmark.name.find(filter) == std::string::npos)
+			continue;
+		if (benchmark.setup)
+			benchmark.setup();
+		BenchmarkResult result = RunBenchmark(benchmark, minTime);
+		printf("%-24s %14.1f %14llu %16.0f\n", result.name.c_str(), result.nsPerIteration, (unsigned long long)result.iterations, result.itemsPerSecond);
+		fflush(stdout);
+		results.push_back(result);
+	}
+
+	if (!jsonPath.empty())
+		WriteJson(results, jsonPath);
+	return 0;
+}
@@ -0,0 +1,3 @@
+#pragma once
+
+int BenchMain(int argc, char* argv[]);
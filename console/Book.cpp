@@ -0,0 +1,118 @@
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+#include "Book.h"
+#include "OpeningBook.h"
+#include "Position.h"
+
+const int BOOK_PROBE_REPEATS = 100000; //    
+
+static volatile int probeSink; //    
+
+//     ,  tournament --log
+static int BuildBook(int argc, char* argv[]) {
+	std::vector<std::string> logPaths;
+	std::string outPath;
+	BookBuildOptions options = { 9, 5, 8, 4 };
+	bool valid = true;
+	for (int i = 0; i < argc; i++) {
+		std::string key = argv[i];
+		if (i + 1 >= argc)
+			valid = false;
+		else if (key == "--log")
+			logPaths.push_back(argv[++i]);
+		else if (key == "--out")
+			outPath = argv[++i];
+		else if (key == "--size")
+			options.gridSize = atoi(argv[++i]);
+		else if (key == "--k")
+			options.winLength = atoi(argv[++i]);
+		else if (key == "--plies")
+			options.maxPly = atoi(argv[++i]);
+		else if (key == "--min-games")
+			options.minGames = atoi(argv[++i]);
+		else
+			valid = false;
+	}
+	if (!valid || logPaths.empty() || outPath.empty() || options.gridSize < 1 || options.gridSize > MAX_GRID_SIZE ||
+		options.winLength < 1 || options.winLength > options.gridSize || options.maxPly < 1 || options.minGames < 1) {
+		fprintf(stderr, ": book build --log  [--log  ...] --out  [--size N] [--k N]\n"
+			"                  [--plies N] [--min-games N]\n");
+		return 1;
+	}
+
+	auto start = std::chrono::steady_clock::now();
+	BookBuildStats stats;
+	if (!BuildOpeningBook(logPaths, options, outPath, stats)) {
+		fprintf(stderr, "    %s\n", outPath.c_str());
+		return 1;
+	}
+	double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	printf("games %llu positions %llu entries %llu seconds %.3f\n", (unsigned long long)stats.games,
+		(unsigned long long)stats.positions, (unsigned long long)stats.entries, seconds);
+	return 0;
+}
+
+//            
+static int ProbeBookMain(int argc, char* argv[]) {
+	std::string bookPath, moves;
+	bool valid = true;
+	for (int i = 0; i < argc; i++) {
+		std::string key = argv[i];
+		if (i + 1 >= argc)
+			valid = false;
+		else if (key == "--book")
+			bookPath = argv[++i];
+		else if (key == "--moves")
+			moves = argv[++i];
+		else
+			valid = false;
+	}
+	if (!valid || bookPath.empty()) {
+		fprintf(stderr, ": book probe --book  [--moves \"x y x y ...\"]\n");
+		return 1;
+	}
+
+	auto start = std::chrono::steady_clock::now();
+	OpeningBook book;
+	if (!OpenOpeningBook(bookPath, book)) {
+		fprintf(stderr, "    %s\n", bookPath.c_str());
+		return 1;
+	}
+	double openSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+	Board board;
+	InitBoard(board, book.header->gridSize, book.header->winLength);
+	if (!ParseMoves(moves, board)) {
+		fprintf(stderr, " : %s\n", moves.c_str());
+		CloseOpeningBook(book);
+		return 1;
+	}
+
+	int move = ProbeBook(book, board);
+	start = std::chrono::steady_clock::now();
+	for (int i = 0; i < BOOK_PROBE_REPEATS; i++)
+		probeSink = ProbeBook(book, board);
+	double probeSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+	printf("size %d k %d plies %d entries %llu open %.1f us probe %.0f ns\n", book.header->gridSize, book.header->winLength,
+		book.header->maxPly, (unsigned long long)book.header->entryCount, openSeconds * 1e6, probeSeconds * 1e9 / BOOK_PROBE_REPEATS);
+	if (move >= 0)
+		printf("bookmove %d %d\n", move % board.size, move / board.size);
+	else
+		printf("bookmove none\n");
+	CloseOpeningBook(book);
+	return 0;
+}
+
+int BookMain(int argc, char* argv[]) {
+	if (argc >= 1 && strcmp(argv[0], "build") == 0)
+		return BuildBook(argc - 1, argv + 1);
+	if (argc >= 1 && strcmp(argv[0], "probe") == 0)
+		return ProbeBookMain(argc - 1, argv + 1);
+	fprintf(stderr, ": book build ... | book probe ...\n");
+	return 1;
+}
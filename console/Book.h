@@ -0,0 +1,3 @@
+#pragma once
+
+int BookMain(int argc, char* argv[]);
@@ -0,0 +1,65 @@
+#include <winsock2.h>
+#include <clocale>
+#include <cstdio>
+#include <cstring>
+#include "Bench.h"
+#include "Book.h"
+#include "MctsAnalysis.h"
+#include "Perft.h"
+#include "Protocol.h"
+#include "SelfPlay.h"
+#include "Server.h"
+#include "Solve.h"
+#include "TimeBench.h"
+#include "Tournament.h"
+#include "TraceMerge.h"
+
+//  :    ,   
+struct ConsoleMode {
+	const char* name;
+	int (*run)(int argc, char* argv[]);
+	const char* description;
+};
+
+const ConsoleMode modes[] = {
+	{ "bench", BenchMain, "   , ,   ,   JSON" },
+	{ "book", BookMain, "          " },
+	{ "mcts", MctsMain, "   MCTS    " },
+	{ "perft", PerftMain, "    :      " },
+	{ "protocol", ProtocolMain, "   stdin/stdout    " },
+	{ "selfplay", SelfPlayMain, "  :     " },
+	{ "server", ServerMain, "   loopback TCP  Unix-" },
+	{ "server-bench", ServerBenchMain, "  :      " },
+	{ "solve", SolveMain, "    df-pn   " },
+	{ "time-bench", TimeBenchMain, "   :      " },
+	{ "tournament", TournamentMain, "         " },
+	{ "trace-merge", TraceMergeMain, "       Chrome trace" },
+};
+
+int main(int argc, char* argv[]) {
+	setlocale(LC_CTYPE, "Russian"); //   ,    
+
+	const ConsoleMode* mode = NULL;
+	for (const ConsoleMode& candidate : modes) {
+		if (argc >= 2 && strcmp(argv[1], candidate.name) == 0)
+			mode = &candidate;
+	}
+
+	if (!mode) {
+		printf(": %s <> []\n\n:\n", argc > 0 ? argv[0] : "console");
+		for (const ConsoleMode& candidate : modes)
+			printf("  %-14s %s\n", candidate.name, candidate.description);
+		return 1;
+	}
+
+	WSADATA wsaData;
+	if (WSAStartup(MAKEWORD(2, 2), &wsaData) != 0) {
+		fprintf(stderr, "   \n");
+		return 1;
+	}
+
+	int code = mode->run(argc - 2, argv + 2);
+
+	WSACleanup();
+	return code;
+}
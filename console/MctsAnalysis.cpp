@@ -0,0 +1,80 @@
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include "MctsAnalysis.h"
+#include "Mcts.h"
+#include "Position.h"
+
+const int MCTS_PRINT_MOVES = 5;
+
+//   MCTS:    ,    
+int MctsMain(int argc, char* argv[]) {
+	int size = 15, winLength = 5, threads = 8, batchSize = 8, latencyUs = 200;
+	MctsLimits limits = { 20000, 0, 2 };
+	std::string moves, networkPath;
+	bool valid = true;
+	for (int i = 0; i < argc; i++) {
+		std::string key = argv[i];
+		if (i + 1 >= argc)
+			valid = false;
+		else if (key == "--size")
+			size = atoi(argv[++i]);
+		else if (key == "--k")
+			winLength = atoi(argv[++i]);
+		else if (key == "--moves")
+			moves = argv[++i];
+		else if (key == "--playouts")
+			limits.playouts = strtoull(argv[++i], NULL, 10);
+		else if (key == "--threads")
+			threads = atoi(argv[++i]);
+		else if (key == "--batch")
+			batchSize = atoi(argv[++i]);
+		else if (key == "--latency-us")
+			latencyUs = atoi(argv[++i]);
+		else if (key == "--radius")
+			limits.candidateRadius = atoi(argv[++i]);
+		else if (key == "--network")
+			networkPath = argv[++i];
+		else
+			valid = false;
+	}
+
+	Board board;
+	bool positionValid = size >= 1 && size <= MAX_GRID_SIZE && winLength >= 1 && winLength <= size;
+	if (positionValid) {
+		InitBoard(board, size, winLength);
+		positionValid = ParseMoves(moves, board);
+	}
+	if (!valid || !positionValid || limits.playouts == 0 || threads < 1 || batchSize < 1 || latencyUs < 0) {
+		fprintf(stderr, ": mcts [--size N] [--k N] [--moves \"x y x y ...\"] [--playouts N] [--threads N]\n"
+			"               [--batch N] [--latency-us N] [--radius N] [--network ]\n"
+			"   --network    \n");
+		return 1;
+	}
+
+	std::unique_ptr<Network> network(new Network());
+	if (!networkPath.empty() && !LoadNetwork(networkPath, *network)) {
+		fprintf(stderr, "    %s\n", networkPath.c_str());
+		return 1;
+	}
+
+	EvalQueue queue;
+	StartEvalQueue(queue, threads, batchSize, latencyUs, networkPath.empty() ? PatternBatchEvaluator() : NetworkBatchEvaluator(*network));
+	limits.threads = threads;
+	MctsResult result = SearchMcts(board, limits, queue);
+	StopEvalQueue(queue);
+	EvalQueueStats stats = ReadEvalQueueStats(queue);
+
+	for (int i = 0; i < (int)result.moves.size() && i < MCTS_PRINT_MOVES; i++) {
+		const MctsMoveStats& move = result.moves[i];
+		printf("move %2d %2d  visits %8d  value %.3f\n", move.move % size, move.move / size, move.visits, move.value);
+	}
+	printf("playouts %llu nodes %llu seconds %.3f playouts/s %.0f\n", (unsigned long long)result.playouts,
+		(unsigned long long)result.nodes, result.seconds, result.seconds > 0 ? result.playouts / result.seconds : 0.0);
+	printf("batches %llu leaves %llu fill %.1f%% queue delay %.1f us\n", (unsigned long long)stats.batches,
+		(unsigned long long)stats.leaves, stats.averageFill * 100.0, stats.averageDelayUs);
+	if (result.bestMove >= 0)
+		printf("bestmove %d %d\n", result.bestMove % size, result.bestMove / size);
+	return 0;
+}
@@ -0,0 +1,3 @@
+#pragma once
+
+int MctsMain(int argc, char* argv[]);
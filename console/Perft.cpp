@@ -0,0 +1,206 @@
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+#include "Perft.h"
+#include "Board.h"
+
+//Perft:       .     .
+//     -    ,     -  
+struct PerftCounts {
+	uint64_t nodes; //    depth
+	uint64_t wins; //,     depth
+	uint64_t draws; //,     depth
+	uint64_t moves; //  
+	uint64_t errors; //   ,    --check
+};
+
+static void AddCounts(PerftCounts& total, const PerftCounts& counts) {
+	total.nodes += counts.nodes;
+	total.wins += counts.wins;
+	total.draws += counts.draws;
+	total.moves += counts.moves;
+	total.errors += counts.errors;
+}
+
+//  3x3  k = 3   0..9.   : 209088   46080 ,  255168 
+static const uint64_t referenceNodes3x3[] = { 1, 9, 72, 504, 3024, 15120, 54720, 148176, 200448, 127872 };
+
+//  :    winLength     
+static bool HasLineSlow(const Board& board, int side) {
+	static const int directions[4][2] = { { 1, 0 }, { 0, 1 }, { 1, 1 }, { 1, -1 } };
+
+	for (int y = 0; y < board.size; y++) {
+		for (int x = 0; x < board.size; x++) {
+			for (int i = 0; i < 4; i++) {
+				int length = 0;
+				int cx = x, cy = y;
+				while (length < board.winLength && cx >= 0 && cx < board.size && cy >= 0 && cy < board.size &&
+					TestBit(board.stones[side], cy * board.size + cx)) {
+					length++;
+					cx += directions[i][0];
+					cy += directions[i][1];
+				}
+				if (length == board.winLength)
+					return true;
+			}
+		}
+	}
+	return false;
+}
+
+static void Perft(Board& board, int depth, bool check, PerftCounts& counts);
+
+//     
+static void PerftMove(Board& board, int cell, int depth, bool check, PerftCounts& counts) {
+	int side = board.sideToMove;
+	bool win = IsWinningMove(board, cell, side);
+
+	Board before;
+	if (check)
+		before = board;
+
+	MakeMove(board, cell);
+	counts.moves++;
+	if (check && win != HasLineSlow(board, side))
+		counts.errors++;
+
+	if (depth == 1)
+		counts.nodes++;
+	if (win)
+		counts.wins++;
+	else if (board.moveCount == board.size * board.size)
+		counts.draws++;
+	else if (depth > 1)
+		Perft(board, depth - 1, check, counts);
+
+	UndoMove(board);
+	if (check && (board.hash != before.hash || memcmp(board.stones, before.stones, sizeof(board.stones)) != 0 ||
+		board.sideToMove != before.sideToMove || board.moveCount != before.moveCount))
+		counts.errors++;
+}
+
+static void Perft(Board& board, int depth, bool check, PerftCounts& counts) {
+	int moves[MAX_CELLS];
+	int count = GenerateMoves(board, moves);
+	if (check && count != board.size * board.size - board.moveCount)
+		counts.errors++;
+
+	for (int i = 0; i < count; i++)
+		PerftMove(board, moves[i], depth, check, counts);
+}
+
+//      --divide
+struct RootCounts {
+	int cell;
+	PerftCounts counts;
+};
+
+//  :             
+static PerftCounts PerftParallel(const Board& root, int depth, int threads, bool check, std::vector<RootCounts>& perMove) {
+	int moves[MAX_CELLS];
+	int count = GenerateMoves(root, moves);
+	perMove.assign(count, RootCounts{ 0, { 0, 0, 0, 0, 0 } });
+	std::atomic<int> next(0);
+
+	auto worker = [&]() {
+		Board board = root;
+		int i;
+		while ((i = next++) < count) {
+			//    ,         
+			PerftCounts counts = { 0, 0, 0, 0, 0 };
+			PerftMove(board, moves[i], depth, check, counts);
+			perMove[i] = RootCounts{ moves[i], counts };
+		}
+	};
+
+	std::vector<std::thread> pool;
+	for (int i = 1; i < threads && i < count; i++)
+		pool.emplace_back(worker);
+	worker();
+	for (std::thread& thread : pool)
+		thread.join();
+
+	PerftCounts total = { 0, 0, 0, 0, 0 };
+	for (const RootCounts& move : perMove)
+		AddCounts(total, move.counts);
+	return total;
+}
+
+int PerftMain(int argc, char* argv[]) {
+	int size = 3, winLength = 0, depth = 0;
+	int threads = (int)std::thread::hardware_concurrency();
+	bool check = false, divide = false;
+	bool valid = true;
+
+	for (int i = 0; i < argc; i++) {
+		std::string key = argv[i];
+		if (key == "--check")
+			check = true;
+		else if (key == "--divide")
+			divide = true;
+		else if (i + 1 < argc && key == "--size")
+			size = atoi(argv[++i]);
+		else if (i + 1 < argc && key == "--k")
+			winLength = atoi(argv[++i]);
+		else if (i + 1 < argc && key == "--depth")
+			depth = atoi(argv[++i]);
+		else if (i + 1 < argc && key == "--threads")
+			threads = atoi(argv[++i]);
+		else
+			valid = false;
+	}
+
+	if (winLength == 0)
+		winLength = size < 5 ? size : 5;
+	if (depth == 0)
+		depth = size == 3 ? 9 : 4; //3x3 ,   -   
+	if (threads < 1)
+		threads = 1;
+	if (!valid || size < 1 || size > MAX_GRID_SIZE || winLength < 1 || winLength > size || depth < 1 || depth > size * size) {
+		fprintf(stderr, ": perft [--size N] [--k N] [--depth N] [--threads N] [--divide] [--check]\n"
+			"  --divide          \n"
+			"  --check    ,        \n");
+		return 1;
+	}
+
+	Board board;
+	InitBoard(board, size, winLength);
+	bool reference = size == 3 && winLength == 3;
+	bool mismatch = false;
+
+	printf("size %d k %d threads %d%s\n", size, winLength, threads, check ? " check" : "");
+	printf("%5s %16s %12s %12s %10s %14s%s\n", "depth", "nodes", "wins", "draws", "seconds", "moves/s", reference ? "  reference" : "");
+	for (int d = 1; d <= depth; d++) {
+		std::vector<RootCounts> perMove;
+		auto start = std::chrono::steady_clock::now();
+		PerftCounts counts = PerftParallel(board, d, threads, check, perMove);
+		double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+		printf("%5d %16llu %12llu %12llu %10.3f %14.0f", d, (unsigned long long)counts.nodes, (unsigned long long)counts.wins,
+			(unsigned long long)counts.draws, seconds, seconds > 0 ? counts.moves / seconds : 0.0);
+		if (reference) {
+			bool ok = counts.nodes == referenceNodes3x3[d];
+			printf("  %s", ok ? "ok" : "MISMATCH");
+			mismatch |= !ok;
+		}
+		printf("\n");
+		fflush(stdout);
+
+		if (counts.errors) {
+			printf("check: %llu \n", (unsigned long long)counts.errors);
+			mismatch = true;
+		}
+
+		if (divide && d == depth) {
+			for (const RootCounts& move : perMove)
+				printf("  %d %d: %llu\n", move.cell % size, move.cell / size, (unsigned long long)move.counts.nodes);
+		}
+	}
+
+	return mismatch ? 2 : 0;
+}
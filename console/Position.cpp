@@ -0,0 +1,16 @@
+#include <sstream>
+#include "Position.h"
+
+bool ParseMoves(const std::string& text, Board& board) {
+	std::istringstream in(text);
+	int x, y;
+	while (in >> x >> y) {
+		if (x < 0 || x >= board.size || y < 0 || y >= board.size)
+			return false;
+		int cell = y * board.size + x;
+		if (!IsEmptyCell(board, cell) || GetResult(board) != RESULT_NONE)
+			return false;
+		MakeMove(board, cell);
+	}
+	return in.eof();
+}
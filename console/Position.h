@@ -0,0 +1,7 @@
+#pragma once
+#include <string>
+#include "Board.h"
+
+// "x y x y ..."     board. false,    ,   ,
+//       
+bool ParseMoves(const std::string& text, Board& board);
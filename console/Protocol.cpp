@@ -0,0 +1,194 @@
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include "Protocol.h"
+#include "Engine.h"
+#include "Metrics.h"
+#include "TimeManager.h"
+
+//    UCI:      stdin,   stdout.
+//   ,  quit   ,     
+// : tttok, readyok, ok ...  bestmove.   newgame, play  undo  
+//      "error ...":
+//  ttt                       -> id name ...,  tttok
+//  isready                   -> readyok
+//  newgame <size> <k>        -> ok | error bad size
+//  play <x> <y>              -> ok <none|x|o|draw> | error illegal move
+//  undo                      -> ok | error nothing to undo
+//  state                     -> ok <size> <k> <x|o> <result> < >
+//  go [movetime ] [nodes n] [depth d] [xtime ] [otime ] [xinc ] [oinc ] [movestogo n] [multipv n]
+//                            ->    (xtime/otime)  TimeManager, movetime  .
+//                                multipv > 1    n  info  multipv k   
+//                            -> info depth .. score .. nodes .. time .. pv x y ...,  bestmove <x> <y>
+//  quit                      ->  ,  
+//                      -> error unknown command
+
+static std::string FormatScore(int score) {
+	if (score >= WIN_SCORE - MAX_PLY)
+		return "win " + std::to_string(WIN_SCORE - score);
+	if (score <= -WIN_SCORE + MAX_PLY)
+		return "loss " + std::to_string(WIN_SCORE + score);
+	return "cp " + std::to_string(score);
+}
+
+static std::string FormatMove(const Board& board, int cell) {
+	return std::to_string(cell % board.size) + " " + std::to_string(cell / board.size);
+}
+
+//    ,    
+static bool ParseMove(std::istream& in, const Board& board, int& cell) {
+	int x = -1, y = -1;
+	if (!(in >> x >> y) || x < 0 || x >= board.size || y < 0 || y >= board.size)
+		return false;
+	cell = y * board.size + x;
+	return IsEmptyCell(board, cell) && GetResult(board) == RESULT_NONE;
+}
+
+static void Go(Engine& engine, const Board& board, std::istream& in, std::ostream& out) {
+	SearchLimits limits = { 0, 0, 0, 0, 0 };
+	int time[2] = { 0, 0 }, increment[2] = { 0, 0 }, movesToGo = 0;
+	std::string key;
+	while (in >> key) {
+		if (key == "movetime")
+			in >> limits.timeMs;
+		else if (key == "nodes")
+			in >> limits.nodes;
+		else if (key == "depth")
+			in >> limits.depth;
+		else if (key == "xtime")
+			in >> time[SIDE_X];
+		else if (key == "otime")
+			in >> time[SIDE_O];
+		else if (key == "xinc")
+			in >> increment[SIDE_X];
+		else if (key == "oinc")
+			in >> increment[SIDE_O];
+		else if (key == "movestogo")
+			in >> movesToGo;
+		else if (key == "multipv")
+			in >> limits.multiPv;
+	}
+
+	if (limits.timeMs == 0 && time[board.sideToMove] > 0) {
+		TimeControl clock = { time[board.sideToMove], increment[board.sideToMove], movesToGo };
+		ApplyTimeBudget(limits, AllocateTime(clock, board));
+	}
+
+	SearchResult result = Search(engine, board, limits, [&](const SearchInfo& info) {
+		out << "info depth " << info.depth;
+		if (limits.multiPv > 1)
+			out << " multipv " << info.line;
+		out << " score " << FormatScore(info.score) << " nodes " << info.nodes << " time " << info.timeMs << " pv";
+		for (int move : info.pv)
+			out << " " << FormatMove(board, move);
+		out << "\n";
+	});
+
+	if (result.bestMove < 0)
+		out << "bestmove none\n";
+	else
+		out << "bestmove " << FormatMove(board, result.bestMove) << "\n";
+}
+
+//  .  false  quit
+bool HandleProtocolLine(ProtocolState& state, const std::string& line, std::ostream& out) {
+	std::istringstream in(line);
+	std::string command;
+	if (!(in >> command))
+		return true;
+
+	Board& board = state.board;
+	if (command == "quit") {
+		return false;
+	}
+	else if (command == "ttt") {
+		out << "id name Tic Tac Toe\n";
+		out << "tttok\n";
+	}
+	else if (command == "isready") {
+		out << "readyok\n";
+	}
+	else if (command == "newgame") {
+		int size = 0, winLength = 0;
+		if (!(in >> size >> winLength) || size < 1 || size > MAX_GRID_SIZE || winLength < 1 || winLength > size) {
+			out << "error bad size\n";
+		}
+		else {
+			InitBoard(board, size, winLength);
+			ClearEngine(state.engine);
+			out << "ok\n";
+		}
+	}
+	else if (command == "play") {
+		int cell;
+		if (!ParseMove(in, board, cell)) {
+			out << "error illegal move\n";
+		}
+		else {
+			MakeMove(board, cell);
+			CountMetric(METRIC_MOVES);
+			out << "ok " << ResultName(GetResult(board)) << "\n";
+		}
+	}
+	else if (command == "undo") {
+		if (board.moveCount == 0) {
+			out << "error nothing to undo\n";
+		}
+		else {
+			UndoMove(board);
+			out << "ok\n";
+		}
+	}
+	else if (command == "state") {
+		out << "ok " << board.size << " " << board.winLength << " " << (board.sideToMove == SIDE_X ? "x " : "o ")
+			<< ResultName(GetResult(board)) << " " << CellsToString(board) << "\n";
+	}
+	else if (command == "go") {
+		Go(state.engine, board, in, out);
+	}
+	else {
+		out << "error unknown command\n";
+	}
+	return true;
+}
+
+void InitProtocol(ProtocolState& state) {
+	InitBoard(state.board, 3, 3);
+	InitEngine(state.engine, 64);
+}
+
+int ProtocolMain(int argc, char* argv[]) {
+	int metricsPort = 0;
+	if (argc == 2 && strcmp(argv[0], "--metrics-port") == 0)
+		metricsPort = atoi(argv[1]);
+	else if (argc != 0) {
+		fprintf(stderr, ": protocol [--metrics-port N]\n");
+		return 1;
+	}
+
+	MetricsServer metrics;
+	if (metricsPort && !StartMetricsServer(metrics, metricsPort))
+		fprintf(stderr, "     %d\n", metricsPort);
+
+	//    :    ,    
+	std::ios::sync_with_stdio(false);
+
+	ProtocolState state;
+	InitProtocol(state);
+
+	std::string line;
+	while (std::getline(std::cin, line)) {
+		if (!line.empty() && line.back() == '\r')
+			line.pop_back();
+		bool running = HandleProtocolLine(state, line, std::cout);
+		std::cout.flush();
+		if (!running)
+			break;
+	}
+
+	StopMetricsServer(metrics);
+	return 0;
+}
@@ -0,0 +1,15 @@
+#pragma once
+#include <ostream>
+#include <string>
+#include "Board.h"
+#include "Engine.h"
+
+//    :    
+struct ProtocolState {
+	Board board;
+	Engine engine;
+};
+
+void InitProtocol(ProtocolState& state);
+bool HandleProtocolLine(ProtocolState& state, const std::string& line, std::ostream& out);
+int ProtocolMain(int argc, char* argv[]);
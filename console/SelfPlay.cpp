@@ -0,0 +1,245 @@
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+#include "SelfPlay.h"
+#include "Engine.h"
+#include "MappedFile.h"
+#include "Metrics.h"
+#include "TrainingData.h"
+
+const size_t SELFPLAY_BUFFER_SIZE = 1 << 20; //       
+const int SELFPLAY_REPORT_MS = 1000;
+
+//  :    ,     -  
+struct SelfPlayOptions {
+	int games;
+	int threads;
+	int size;
+	int winLength;
+	int randomPlies; //     ,    
+	uint64_t nodes;
+	int depth;
+	int tableMegabytes;
+	unsigned seed;
+	std::string directory;
+	int shardMegabytes;
+	bool verify; //     
+};
+
+//   side: 0 - , 1 - , 2 - 
+static int ResultFor(int result, int side) {
+	if (result == RESULT_DRAW || result == RESULT_NONE)
+		return 1;
+	int winner = result == RESULT_X_WIN ? SIDE_X : SIDE_O;
+	return winner == side ? 2 : 0;
+}
+
+//     [-WIN_SCORE, WIN_SCORE].   -   
+static bool IsSearchedScore(int score) {
+	return score >= -WIN_SCORE && score <= WIN_SCORE;
+}
+
+// .     ,      .
+//,        , ,     
+static uint64_t PlaySelfPlayGame(Engine& engine, const SelfPlayOptions& options, int game, std::vector<TrainingSample>& samples, std::vector<uint8_t>& buffer) {
+	std::mt19937 rng(options.seed + game);
+	Board board;
+	InitBoard(board, options.size, options.winLength);
+	for (int i = 0; i < options.randomPlies && board.moveCount + 1 < board.size * board.size; i++) {
+		int moves[MAX_CELLS];
+		int count = GenerateMoves(board, moves);
+		int candidates = 0;
+		for (int j = 0; j < count; j++) {
+			if (!IsWinningMove(board, moves[j], board.sideToMove))
+				moves[candidates++] = moves[j];
+		}
+		if (candidates == 0)
+			break;
+		MakeMove(board, moves[rng() % candidates]);
+	}
+
+	ClearEngine(engine);
+	samples.clear();
+	int result;
+	while ((result = GetResult(board)) == RESULT_NONE) {
+		SearchLimits limits = { options.depth, options.nodes, 0, 0, 0 };
+		SearchResult search = Search(engine, board, limits, NULL);
+		if (search.bestMove < 0)
+			break;
+		if (search.depth == 0 || !IsSearchedScore(search.score)) {
+			MakeMove(board, search.bestMove);
+			CountMetric(METRIC_MOVES);
+			continue;
+		}
+
+		samples.emplace_back();
+		TrainingSample& sample = samples.back();
+		sample.board = board;
+		sample.score = search.score;
+		sample.policyCount = 1;
+		sample.policy[0].cell = (uint16_t)search.bestMove;
+		sample.policy[0].visits = 1;
+		MakeMove(board, search.bestMove);
+		CountMetric(METRIC_MOVES);
+	}
+
+	for (TrainingSample& sample : samples) {
+		sample.result = ResultFor(result, sample.board.sideToMove);
+		EncodeSample(buffer, sample);
+	}
+	return samples.size();
+}
+
+//        .   - - 
+static bool VerifyShards(const SelfPlayOptions& options, int shardCount, uint64_t& samples) {
+	samples = 0;
+	for (int i = 0; i < shardCount; i++) {
+		MappedFile file;
+		if (!OpenMappedFile(ShardPath(options.directory, i), file))
+			return false;
+		const ShardHeader* header = (const ShardHeader*)file.data;
+		bool ok = file.size >= sizeof(ShardHeader) && header->magic == SHARD_MAGIC && header->version == SHARD_VERSION &&
+			header->gridSize == options.size && header->winLength == options.winLength;
+		const uint8_t* pos = file.data + sizeof(ShardHeader);
+		const uint8_t* end = file.data + file.size;
+		std::unique_ptr<TrainingSample> sample(new TrainingSample());
+		while (ok && pos < end) {
+			ok = DecodeSample(pos, end, *header, *sample) && IsSearchedScore(sample->score);
+			samples += ok;
+		}
+		CloseMappedFile(file);
+		if (!ok)
+			return false;
+	}
+	return true;
+}
+
+static bool ParseSelfPlayOptions(int argc, char* argv[], SelfPlayOptions& options) {
+	options = { 100, (int)std::thread::hardware_concurrency(), 9, 5, 4, 2000, 0, 4, 1, "selfplay", 64, false };
+	for (int i = 0; i < argc; i++) {
+		std::string key = argv[i];
+		if (key == "--verify") {
+			options.verify = true;
+			continue;
+		}
+		if (i + 1 >= argc)
+			return false;
+		std::string value = argv[++i];
+		if (key == "--games")
+			options.games = atoi(value.c_str());
+		else if (key == "--threads")
+			options.threads = atoi(value.c_str());
+		else if (key == "--size")
+			options.size = atoi(value.c_str());
+		else if (key == "--k")
+			options.winLength = atoi(value.c_str());
+		else if (key == "--random-plies")
+			options.randomPlies = atoi(value.c_str());
+		else if (key == "--nodes")
+			options.nodes = strtoull(value.c_str(), NULL, 10);
+		else if (key == "--depth")
+			options.depth = atoi(value.c_str());
+		else if (key == "--hash")
+			options.tableMegabytes = atoi(value.c_str());
+		else if (key == "--seed")
+			options.seed = (unsigned)strtoul(value.c_str(), NULL, 10);
+		else if (key == "--out")
+			options.directory = value;
+		else if (key == "--shard-mb")
+			options.shardMegabytes = atoi(value.c_str());
+		else
+			return false;
+	}
+	if (options.threads < 1)
+		options.threads = 1;
+	return options.games > 0 && options.size >= 1 && options.size <= MAX_GRID_SIZE && options.winLength >= 1 &&
+		options.winLength <= options.size && options.randomPlies >= 0 && options.tableMegabytes > 0 && options.shardMegabytes > 0 &&
+		(options.nodes > 0 || options.depth > 0);
+}
+
+int SelfPlayMain(int argc, char* argv[]) {
+	SelfPlayOptions options;
+	if (!ParseSelfPlayOptions(argc, argv, options)) {
+		fprintf(stderr, ": selfplay [--games N] [--threads N] [--size N] [--k N] [--random-plies N]\n"
+			"                [--nodes N] [--depth N] [--hash ] [--seed N] [--out ] [--shard-mb ] [--verify]\n");
+		return 1;
+	}
+
+	ShardWriter writer;
+	if (!OpenShardWriter(writer, options.directory, options.size, options.winLength, (uint64_t)options.shardMegabytes << 20)) {
+		fprintf(stderr, "    %s\n", options.directory.c_str());
+		return 1;
+	}
+
+	std::atomic<int> nextGame(0), finishedGames(0);
+	std::atomic<uint64_t> positions(0);
+	auto worker = [&]() {
+		std::unique_ptr<Engine> engine(new Engine());
+		InitEngine(*engine, options.tableMegabytes);
+		std::vector<TrainingSample> samples;
+		std::vector<uint8_t> buffer;
+		buffer.reserve(SELFPLAY_BUFFER_SIZE + (1 << 16));
+		int game;
+		while ((game = nextGame++) < options.games) {
+			positions += PlaySelfPlayGame(*engine, options, game, samples, buffer);
+			finishedGames++;
+			if (buffer.size() >= SELFPLAY_BUFFER_SIZE) {
+				SubmitShardBuffer(writer, buffer);
+				buffer.reserve(SELFPLAY_BUFFER_SIZE + (1 << 16));
+			}
+		}
+		SubmitShardBuffer(writer, buffer);
+	};
+
+	auto start = std::chrono::steady_clock::now();
+	std::vector<std::thread> threads;
+	for (int i = 0; i < options.threads; i++)
+		threads.emplace_back(worker);
+
+	//      
+	uint64_t lastPositions = 0;
+	auto lastReport = start;
+	while (finishedGames < options.games) {
+		std::this_thread::sleep_for(std::chrono::milliseconds(50));
+		auto now = std::chrono::steady_clock::now();
+		if (now - lastReport >= std::chrono::milliseconds(SELFPLAY_REPORT_MS)) {
+			uint64_t current = positions;
+			double seconds = std::chrono::duration<double>(now - lastReport).count();
+			printf("%8.1f s  games %6d/%d  positions %10llu  %8.0f positions/s\n", std::chrono::duration<double>(now - start).count(),
+				finishedGames.load(), options.games, (unsigned long long)current, (current - lastPositions) / seconds);
+			fflush(stdout);
+			lastPositions = current;
+			lastReport = now;
+		}
+	}
+	for (std::thread& thread : threads)
+		thread.join();
+	bool written = CloseShardWriter(writer);
+	double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+	printf("games            %d (%d threads)\n", options.games, options.threads);
+	printf("positions        %llu\n", (unsigned long long)positions.load());
+	printf("positions/s      %.0f\n", positions / seconds);
+	printf("shards           %d, %.1f MB, %.1f bytes/position\n", writer.shardCount, writer.totalBytes / 1048576.0,
+		positions ? (double)writer.totalBytes / positions : 0.0);
+	if (!written) {
+		fprintf(stderr, "     %s\n", options.directory.c_str());
+		return 1;
+	}
+
+	if (options.verify) {
+		uint64_t samples;
+		if (!VerifyShards(options, writer.shardCount, samples) || samples != positions) {
+			fprintf(stderr, "      :  %llu   %llu\n", (unsigned long long)samples, (unsigned long long)positions.load());
+			return 1;
+		}
+		printf("verified         %llu records\n", (unsigned long long)samples);
+	}
+	return 0;
+}
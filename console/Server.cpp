@@ -0,0 +1,393 @@
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#include <afunix.h>
+#include <cstdio>
+#include <cstdlib>
+#include <sstream>
+#include "Server.h"
+#include "GameLog.h"
+#include "Metrics.h"
+
+#pragma comment(lib, "Ws2_32.lib")
+
+void InitSessionPool(SessionPool& pool, int capacity) {
+	pool.slab.assign(capacity, Session());
+	pool.freeList.resize(capacity);
+	//     ,     
+	for (int i = 0; i < capacity; i++)
+		pool.freeList[i] = capacity - 1 - i;
+	pool.usedCount = 0;
+}
+
+int OpenSession(SessionPool& pool, int size, int winLength, uint64_t owner) {
+	if (pool.freeList.empty())
+		return -1;
+
+	int id = pool.freeList.back();
+	pool.freeList.pop_back();
+
+	Session& session = pool.slab[id];
+	InitBoard(session.board, size, winLength);
+	session.result = RESULT_NONE;
+	session.used = true;
+	session.owner = owner;
+	pool.usedCount++;
+	return id;
+}
+
+Session* FindSession(SessionPool& pool, int id) {
+	if (id < 0 || id >= (int)pool.slab.size() || !pool.slab[id].used)
+		return NULL;
+	return &pool.slab[id];
+}
+
+void CloseSession(SessionPool& pool, int id) {
+	Session* session = FindSession(pool, id);
+	if (!session)
+		return;
+	session->used = false;
+	pool.freeList.push_back(id);
+	pool.usedCount--;
+}
+
+//            .
+//,         , 
+const size_t MAX_CONNECTION_BUFFER = 64 * 1024;
+
+// 
+struct Connection {
+	SOCKET socket;
+	uint64_t id; //      ,     
+	std::string input; //    
+	std::string output; //,      
+	std::vector<int> sessions; //,   
+};
+
+//  :
+//  new <size> <k>       -> ok <id>
+//  move <id> <x> <y>    -> ok <none|x|o|draw>
+//  state <id>           -> ok <size> <k> <x|o> <result> < >
+//  close <id>           -> ok
+//     ,   move/state/close - error not owner
+static void HandleCommand(SessionPool& pool, Connection& connection, GameLogWriter* log, const std::string& line, std::string& reply) {
+	std::istringstream in(line);
+	std::string command;
+	in >> command;
+
+	if (command == "new") {
+		int size = 0, winLength = 0;
+		if (!(in >> size >> winLength) || size < 1 || size > MAX_GRID_SIZE || winLength < 1 || winLength > size) {
+			reply = "error bad size";
+			return;
+		}
+		int id = OpenSession(pool, size, winLength, connection.id);
+		if (id < 0) {
+			reply = "error server full";
+			return;
+		}
+		connection.sessions.push_back(id);
+		reply = "ok " + std::to_string(id);
+		return;
+	}
+
+	int id = -1;
+	in >> id;
+	Session* session = FindSession(pool, id);
+	if (command != "move" && command != "state" && command != "close") {
+		reply = "error unknown command";
+		return;
+	}
+	if (!session) {
+		reply = "error no session";
+		return;
+	}
+	if (session->owner != connection.id) {
+		reply = "error not owner";
+		return;
+	}
+
+	if (command == "move") {
+		int x = -1, y = -1;
+		Board& board = session->board;
+		if (!(in >> x >> y) || x < 0 || x >= board.size || y < 0 || y >= board.size ||
+			session->result != RESULT_NONE || !IsEmptyCell(board, y * board.size + x)) {
+			reply = "error illegal move";
+			return;
+		}
+
+		MakeMove(board, y * board.size + x);
+		CountMetric(METRIC_MOVES);
+		session->result = GetResult(board);
+		if (session->result != RESULT_NONE && log)
+			WriteGame(*log, board, session->result);
+
+		reply = std::string("ok ") + ResultName(session->result);
+	}
+	else if (command == "state") {
+		Board& board = session->board;
+		reply = "ok " + std::to_string(board.size) + " " + std::to_string(board.winLength) + " " +
+			(board.sideToMove == SIDE_X ? "x " : "o ") + ResultName(session->result) + " " + CellsToString(board);
+	}
+	else {
+		CloseSession(pool, id);
+		for (size_t i = 0; i < connection.sessions.size(); i++) {
+			if (connection.sessions[i] == id) {
+				connection.sessions[i] = connection.sessions.back();
+				connection.sessions.pop_back();
+				break;
+			}
+		}
+		reply = "ok";
+	}
+}
+
+static void SetNonBlocking(SOCKET s) {
+	u_long mode = 1;
+	ioctlsocket(s, FIONBIO, &mode);
+}
+
+static SOCKET OpenListenSocket(const ServerOptions& options) {
+	SOCKET listener;
+	if (!options.unixPath.empty()) {
+		listener = socket(AF_UNIX, SOCK_STREAM, 0);
+		if (listener == INVALID_SOCKET)
+			return INVALID_SOCKET;
+
+		sockaddr_un address = { 0 };
+		address.sun_family = AF_UNIX;
+		if (options.unixPath.size() >= sizeof(address.sun_path)) {
+			closesocket(listener);
+			return INVALID_SOCKET;
+		}
+		memcpy(address.sun_path, options.unixPath.c_str(), options.unixPath.size() + 1);
+		remove(options.unixPath.c_str()); //      bind
+		if (bind(listener, (sockaddr*)&address, sizeof(address)) == SOCKET_ERROR) {
+			closesocket(listener);
+			return INVALID_SOCKET;
+		}
+	}
+	else {
+		listener = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+		if (listener == INVALID_SOCKET)
+			return INVALID_SOCKET;
+
+		int reuse = 1;
+		setsockopt(listener, SOL_SOCKET, SO_REUSEADDR, (const char*)&reuse, sizeof(reuse));
+
+		sockaddr_in address = { 0 };
+		address.sin_family = AF_INET;
+		address.sin_addr.s_addr = htonl(INADDR_LOOPBACK); //  
+		address.sin_port = htons((u_short)options.port);
+		if (bind(listener, (sockaddr*)&address, sizeof(address)) == SOCKET_ERROR) {
+			closesocket(listener);
+			return INVALID_SOCKET;
+		}
+	}
+
+	if (listen(listener, SOMAXCONN) == SOCKET_ERROR) {
+		closesocket(listener);
+		return INVALID_SOCKET;
+	}
+	SetNonBlocking(listener);
+	return listener;
+}
+
+//  ,      
+static bool FlushOutput(Connection& connection) {
+	while (!connection.output.empty()) {
+		int sent = send(connection.socket, connection.output.data(), (int)connection.output.size(), 0);
+		if (sent == SOCKET_ERROR)
+			return WSAGetLastError() == WSAEWOULDBLOCK;
+		connection.output.erase(0, sent);
+	}
+	return true;
+}
+
+//       . false -   
+static bool HandleLines(SessionPool& pool, Connection& connection, GameLogWriter* log) {
+	size_t start = 0, end;
+	std::string reply;
+	while ((end = connection.input.find('\n', start)) != std::string::npos) {
+		std::string line = connection.input.substr(start, end - start);
+		if (!line.empty() && line.back() == '\r')
+			line.pop_back();
+		start = end + 1;
+
+		if (line.empty())
+			continue;
+		if (line == "quit")
+			return false;
+
+		HandleCommand(pool, connection, log, line, reply);
+		connection.output += reply;
+		connection.output += '\n';
+		//    :  -   ,    
+		if (connection.output.size() > MAX_CONNECTION_BUFFER && (!FlushOutput(connection) || connection.output.size() > MAX_CONNECTION_BUFFER))
+			return false;
+	}
+	connection.input.erase(0, start);
+	return connection.input.size() <= MAX_CONNECTION_BUFFER;
+}
+
+// ,  ,      .    
+//,       ,     
+static bool ReadInput(SessionPool& pool, Connection& connection, GameLogWriter* log) {
+	char buffer[4096];
+	for (;;) {
+		int received = recv(connection.socket, buffer, sizeof(buffer), 0);
+		if (received == 0)
+			return false;
+		if (received == SOCKET_ERROR) {
+			if (WSAGetLastError() == WSAEWOULDBLOCK)
+				break;
+			return false;
+		}
+		connection.input.append(buffer, received);
+		if (!HandleLines(pool, connection, log))
+			return false;
+	}
+	return FlushOutput(connection);
+}
+
+// :        
+bool RunServer(const ServerOptions& options, std::atomic<bool>& running, std::atomic<bool>* ready) {
+	SOCKET listener = OpenListenSocket(options);
+	if (listener == INVALID_SOCKET) {
+		fprintf(stderr, "    \n");
+		return false;
+	}
+
+	GameLogWriter log;
+	bool logging = !options.logPath.empty() && OpenGameLogWriter(options.logPath, log);
+
+	SessionPool pool;
+	InitSessionPool(pool, options.capacity);
+
+	std::vector<Connection> connections;
+	std::vector<WSAPOLLFD> fds;
+	uint64_t nextConnectionId = 1;
+	bool ok = true;
+
+	if (ready)
+		*ready = true;
+
+	while (running) {
+		fds.resize(connections.size() + 1);
+		fds[0].fd = listener;
+		fds[0].events = POLLRDNORM;
+		fds[0].revents = 0;
+		for (size_t i = 0; i < connections.size(); i++) {
+			fds[i + 1].fd = connections[i].socket;
+			fds[i + 1].events = POLLRDNORM | (connections[i].output.empty() ? 0 : POLLWRNORM);
+			fds[i + 1].revents = 0;
+		}
+
+		//  ,    .     POLLNVAL
+		//   revents,    WSAPoll     : 
+		int polled = WSAPoll(fds.data(), (ULONG)fds.size(), 100);
+		if (polled == SOCKET_ERROR) {
+			fprintf(stderr, " WSAPoll: %d\n", WSAGetLastError());
+			ok = false;
+			break;
+		}
+		if (polled == 0)
+			continue;
+
+		//   :    
+		for (size_t i = connections.size(); i > 0; i--) {
+			Connection& connection = connections[i - 1];
+			short revents = fds[i].revents;
+			bool alive = true;
+
+			if (revents & POLLRDNORM)
+				alive = ReadInput(pool, connection, logging ? &log : NULL);
+			else if (revents & POLLWRNORM)
+				alive = FlushOutput(connection);
+			if (revents & (POLLERR | POLLHUP | POLLNVAL))
+				alive = false;
+
+			//    :        
+			if (!alive) {
+				for (int id : connection.sessions) {
+					Session* session = FindSession(pool, id);
+					if (session && session->owner == connection.id)
+						CloseSession(pool, id);
+				}
+				closesocket(connection.socket);
+				connection = std::move(connections.back());
+				connections.pop_back();
+			}
+		}
+
+		if (fds[0].revents & POLLRDNORM) {
+			SOCKET client;
+			while ((client = accept(listener, NULL, NULL)) != INVALID_SOCKET) {
+				SetNonBlocking(client);
+				if (options.unixPath.empty()) {
+					int noDelay = 1;
+					setsockopt(client, IPPROTO_TCP, TCP_NODELAY, (const char*)&noDelay, sizeof(noDelay));
+				}
+				Connection connection;
+				connection.socket = client;
+				connection.id = nextConnectionId++;
+				connections.push_back(std::move(connection));
+			}
+		}
+	}
+
+	for (Connection& connection : connections)
+		closesocket(connection.socket);
+	closesocket(listener);
+	if (!options.unixPath.empty())
+		remove(options.unixPath.c_str());
+	if (logging) {
+		CloseGameLogWriter(log);
+		if (log.failed)
+			fprintf(stderr, " %s   \n", options.logPath.c_str());
+	}
+	return ok;
+}
+
+//     .  false   
+bool ParseServerOption(ServerOptions& options, int argc, char* argv[], int& i) {
+	std::string key = argv[i];
+	if (i + 1 >= argc)
+		return false;
+
+	if (key == "--port")
+		options.port = atoi(argv[++i]);
+	else if (key == "--unix")
+		options.unixPath = argv[++i];
+	else if (key == "--capacity")
+		options.capacity = atoi(argv[++i]);
+	else if (key == "--log")
+		options.logPath = argv[++i];
+	else if (key == "--metrics-port")
+		options.metricsPort = atoi(argv[++i]);
+	else
+		return false;
+	return true;
+}
+
+int ServerMain(int argc, char* argv[]) {
+	ServerOptions options = { 7777, "", 65536, "", 0 };
+	for (int i = 0; i < argc; i++) {
+		if (!ParseServerOption(options, argc, argv, i)) {
+			fprintf(stderr, ": server [--port N | --unix ] [--capacity N] [--log ] [--metrics-port N]\n");
+			return 1;
+		}
+	}
+	if (options.capacity < 1) {
+		fprintf(stderr, "    \n");
+		return 1;
+	}
+
+	MetricsServer metrics;
+	if (options.metricsPort && !StartMetricsServer(metrics, options.metricsPort))
+		fprintf(stderr, "     %d\n", options.metricsPort);
+
+	std::atomic<bool> running(true);
+	bool ok = RunServer(options, running, NULL);
+	StopMetricsServer(metrics);
+	return ok ? 0 : 1;
+}
@@ -0,0 +1,39 @@
+#pragma once
+#include <atomic>
+#include <string>
+#include <vector>
+#include "Board.h"
+
+//   
+struct Session {
+	Board board;
+	int result;
+	bool used;
+	uint64_t owner; // ,  .     
+};
+
+//       ,    
+struct SessionPool {
+	std::vector<Session> slab;
+	std::vector<int> freeList;
+	int usedCount;
+};
+
+void InitSessionPool(SessionPool& pool, int capacity);
+int OpenSession(SessionPool& pool, int size, int winLength, uint64_t owner);
+Session* FindSession(SessionPool& pool, int id);
+void CloseSession(SessionPool& pool, int id);
+
+// 
+struct ServerOptions {
+	int port; //  127.0.0.1,    unixPath
+	std::string unixPath; // Unix-
+	int capacity; //    
+	std::string logPath; //  ,  -  
+	int metricsPort; // HTTP   Prometheus  127.0.0.1, 0 -  
+};
+
+bool ParseServerOption(ServerOptions& options, int argc, char* argv[], int& i);
+bool RunServer(const ServerOptions& options, std::atomic<bool>& running, std::atomic<bool>* ready);
+int ServerMain(int argc, char* argv[]);
+int ServerBenchMain(int argc, char* argv[]);
@@ -0,0 +1,227 @@
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#include <afunix.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <thread>
+#include "Server.h"
+
+const int SERVER_BENCH_CORES = 1; //      
+
+// :          
+struct BenchClient {
+	SOCKET socket;
+	std::string input;
+	std::vector<int> ids; //   
+	std::vector<Board> boards; //    ,    
+	std::vector<double> latencies; //   , 
+	int held; //,    
+	int started; // ,   ,    
+	bool failed;
+};
+
+static SOCKET ConnectToServer(const ServerOptions& options) {
+	SOCKET s;
+	if (!options.unixPath.empty()) {
+		s = socket(AF_UNIX, SOCK_STREAM, 0);
+		sockaddr_un address = { 0 };
+		address.sun_family = AF_UNIX;
+		if (options.unixPath.size() >= sizeof(address.sun_path)) {
+			closesocket(s);
+			return INVALID_SOCKET;
+		}
+		memcpy(address.sun_path, options.unixPath.c_str(), options.unixPath.size() + 1);
+		if (s != INVALID_SOCKET && connect(s, (sockaddr*)&address, sizeof(address)) == SOCKET_ERROR) {
+			closesocket(s);
+			return INVALID_SOCKET;
+		}
+	}
+	else {
+		s = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+		sockaddr_in address = { 0 };
+		address.sin_family = AF_INET;
+		address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+		address.sin_port = htons((u_short)options.port);
+		if (s != INVALID_SOCKET && connect(s, (sockaddr*)&address, sizeof(address)) == SOCKET_ERROR) {
+			closesocket(s);
+			return INVALID_SOCKET;
+		}
+		int noDelay = 1;
+		setsockopt(s, IPPROTO_TCP, TCP_NODELAY, (const char*)&noDelay, sizeof(noDelay));
+	}
+	return s;
+}
+
+//      
+static bool Request(BenchClient& client, const std::string& command, std::string& reply) {
+	std::string line = command + "\n";
+	if (send(client.socket, line.data(), (int)line.size(), 0) != (int)line.size())
+		return false;
+
+	size_t end;
+	while ((end = client.input.find('\n')) == std::string::npos) {
+		char buffer[1024];
+		int received = recv(client.socket, buffer, sizeof(buffer), 0);
+		if (received <= 0)
+			return false;
+		client.input.append(buffer, received);
+	}
+	reply = client.input.substr(0, end);
+	client.input.erase(0, end + 1);
+	return reply.compare(0, 2, "ok") == 0;
+}
+
+static bool StartGame(BenchClient& client, size_t slot, int size, int winLength) {
+	std::string reply;
+	if (!Request(client, "new " + std::to_string(size) + " " + std::to_string(winLength), reply))
+		return false;
+	client.ids[slot] = atoi(reply.c_str() + 3);
+	InitBoard(client.boards[slot], size, winLength);
+	client.started++;
+	return true;
+}
+
+static void RunBenchClient(BenchClient& client, const ServerOptions& options, int sessions, int moves, int size, int winLength, unsigned seed) {
+	client.failed = true;
+	client.held = 0;
+	client.started = 0;
+	client.socket = ConnectToServer(options);
+	if (client.socket == INVALID_SOCKET)
+		return;
+
+	client.ids.resize(sessions);
+	client.boards.resize(sessions);
+	for (int i = 0; i < sessions; i++) {
+		if (!StartGame(client, i, size, winLength))
+			return;
+		client.held++;
+	}
+
+	std::mt19937 rng(seed);
+	client.latencies.reserve(moves);
+	std::string reply;
+	for (int i = 0; i < moves; i++) {
+		size_t slot = i % sessions;
+		Board& board = client.boards[slot];
+
+		int cell;
+		do {
+			cell = rng() % (board.size * board.size);
+		} while (!IsEmptyCell(board, cell));
+
+		std::string command = "move " + std::to_string(client.ids[slot]) + " " +
+			std::to_string(cell % board.size) + " " + std::to_string(cell / board.size);
+
+		auto start = std::chrono::steady_clock::now();
+		if (!Request(client, command, reply))
+			return;
+		auto finish = std::chrono::steady_clock::now();
+		client.latencies.push_back(std::chrono::duration<double, std::micro>(finish - start).count());
+
+		MakeMove(board, cell);
+		//          
+		if (reply != "ok none") {
+			if (!Request(client, "close " + std::to_string(client.ids[slot]), reply) || !StartGame(client, slot, size, winLength))
+				return;
+		}
+	}
+
+	Request(client, "quit", reply);
+	closesocket(client.socket);
+	client.failed = false;
+}
+
+static double Percentile(std::vector<double>& values, double fraction) {
+	size_t index = (size_t)(fraction * (values.size() - 1));
+	std::nth_element(values.begin(), values.begin() + index, values.end());
+	return values[index];
+}
+
+//      (   )    
+int ServerBenchMain(int argc, char* argv[]) {
+	ServerOptions options = { 7778, "", 65536, "", 0 };
+	int clients = 8, sessions = 10000, moves = 200000, size = 3, winLength = 3;
+
+	for (int i = 0; i < argc; i++) {
+		std::string key = argv[i];
+		if (ParseServerOption(options, argc, argv, i))
+			continue;
+		if (i + 1 >= argc) {
+			fprintf(stderr, ": server-bench [--port N | --unix ] [--clients N] [--sessions N] [--moves N] [--size N] [--k N]\n");
+			return 1;
+		}
+		if (key == "--clients")
+			clients = atoi(argv[++i]);
+		else if (key == "--sessions")
+			sessions = atoi(argv[++i]);
+		else if (key == "--moves")
+			moves = atoi(argv[++i]);
+		else if (key == "--size")
+			size = atoi(argv[++i]);
+		else if (key == "--k")
+			winLength = atoi(argv[++i]);
+		else {
+			fprintf(stderr, "  %s\n", key.c_str());
+			return 1;
+		}
+	}
+
+	if (clients < 1 || sessions < clients || moves < clients || size < 1 || size > MAX_GRID_SIZE || winLength < 1 || winLength > size) {
+		fprintf(stderr, "  \n");
+		return 1;
+	}
+	if (options.capacity < sessions)
+		options.capacity = sessions;
+
+	std::atomic<bool> running(true), ready(false);
+	std::atomic<bool> serverOk(true);
+	std::thread server([&]() { serverOk = RunServer(options, running, &ready); });
+	while (!ready && serverOk)
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+	if (!serverOk) {
+		server.join();
+		fprintf(stderr, "  ,  \n");
+		return 1;
+	}
+
+	std::vector<BenchClient> benchClients(clients);
+	std::vector<std::thread> threads;
+	auto start = std::chrono::steady_clock::now();
+	for (int i = 0; i < clients; i++) {
+		int clientSessions = sessions / clients + (i < sessions % clients ? 1 : 0);
+		int clientMoves = moves / clients + (i < moves % clients ? 1 : 0);
+		threads.emplace_back(RunBenchClient, std::ref(benchClients[i]), std::cref(options), clientSessions, clientMoves, size, winLength, 1234u + i);
+	}
+	for (std::thread& thread : threads)
+		thread.join();
+	double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+	running = false;
+	server.join();
+
+	std::vector<double> latencies;
+	int held = 0, started = 0;
+	for (BenchClient& client : benchClients) {
+		if (client.failed) {
+			fprintf(stderr, "   ,  \n");
+			return 1;
+		}
+		latencies.insert(latencies.end(), client.latencies.begin(), client.latencies.end());
+		held += client.held;
+		started += client.started;
+	}
+
+	//    -  ,    ,    
+	printf("sessions         %d held, %d served\n", held, started);
+	printf("clients          %d\n", clients);
+	printf("moves            %zu\n", latencies.size());
+	printf("sessions/core    %.0f\n", (double)held / SERVER_BENCH_CORES);
+	printf("moves/s/core     %.0f\n", latencies.size() / seconds / SERVER_BENCH_CORES);
+	printf("latency p50 us   %.1f\n", Percentile(latencies, 0.50));
+	printf("latency p99 us   %.1f\n", Percentile(latencies, 0.99));
+	printf("latency p999 us  %.1f\n", Percentile(latencies, 0.999));
+	return 0;
+}
@@ -0,0 +1,120 @@
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include "Solve.h"
+#include "ProofSearch.h"
+#include "Position.h"
+
+//    df-pn.    
+//         (--resume)
+struct SolveOptions {
+	int size;
+	int winLength;
+	std::string moves; // "x y x y ..."   
+	int tableMegabytes;
+	uint64_t nodes;
+	int timeMs;
+	int progressMs;
+	std::string checkpointPath;
+	int checkpointSeconds; //       
+	std::string resumePath;
+};
+
+static const char* SideName(int side) {
+	return side == SIDE_X ? "x" : "o";
+}
+
+int SolveMain(int argc, char* argv[]) {
+	SolveOptions options = { 4, 0, "", 256, 0, 0, 5000, "", 60, "" };
+	bool valid = true;
+	for (int i = 0; i < argc; i++) {
+		std::string key = argv[i];
+		if (i + 1 >= argc)
+			valid = false;
+		else if (key == "--size")
+			options.size = atoi(argv[++i]);
+		else if (key == "--k")
+			options.winLength = atoi(argv[++i]);
+		else if (key == "--moves")
+			options.moves = argv[++i];
+		else if (key == "--hash")
+			options.tableMegabytes = atoi(argv[++i]);
+		else if (key == "--nodes")
+			options.nodes = strtoull(argv[++i], NULL, 10);
+		else if (key == "--time")
+			options.timeMs = atoi(argv[++i]) * 1000;
+		else if (key == "--progress")
+			options.progressMs = atoi(argv[++i]) * 1000;
+		else if (key == "--checkpoint")
+			options.checkpointPath = argv[++i];
+		else if (key == "--checkpoint-every")
+			options.checkpointSeconds = atoi(argv[++i]);
+		else if (key == "--resume")
+			options.resumePath = argv[++i];
+		else
+			valid = false;
+	}
+	if (options.winLength == 0)
+		options.winLength = options.size < 4 ? options.size : 4;
+
+	//         
+	if (valid && options.resumePath.empty() && options.size > PROOF_MAX_SIZE) {
+		fprintf(stderr, "     %dx%d,   %dx%d\n", PROOF_MAX_SIZE, PROOF_MAX_SIZE, options.size, options.size);
+		return 1;
+	}
+
+	ProofSolver solver;
+	Board board;
+	bool positionValid = options.size >= 3 && options.size <= MAX_GRID_SIZE && options.winLength >= 1 && options.winLength <= options.size;
+	if (valid && positionValid && options.resumePath.empty()) {
+		InitBoard(board, options.size, options.winLength);
+		positionValid = ParseMoves(options.moves, board);
+	}
+	if (!valid || !positionValid || options.tableMegabytes <= 0 || options.progressMs <= 0 || options.checkpointSeconds <= 0) {
+		fprintf(stderr, ": solve [--size N] [--k N] [--moves \"x y x y ...\"] [--hash ]\n"
+			"                [--nodes N] [--time ] [--progress ]\n"
+			"                [--checkpoint ] [--checkpoint-every ] [--resume ]\n"
+			"  --resume     :      \n");
+		return 1;
+	}
+
+	InitSolver(solver, options.resumePath.empty() ? options.tableMegabytes : 1);
+	if (!options.resumePath.empty()) {
+		if (!LoadProofCheckpoint(solver, board, options.resumePath)) {
+			fprintf(stderr, "     %s\n", options.resumePath.c_str());
+			return 1;
+		}
+		printf("resume %s: %llu , %llu \n", options.resumePath.c_str(), (unsigned long long)solver.used, (unsigned long long)solver.totalNodes);
+	}
+
+	printf("size %d k %d moves %d side %s table %llu \n", board.size, board.winLength, board.moveCount,
+		SideName(board.sideToMove), (unsigned long long)solver.table.size());
+	fflush(stdout);
+
+	auto lastCheckpoint = std::chrono::steady_clock::now();
+	ProofLimits limits = { options.nodes, options.timeMs, options.progressMs };
+	ProofResult result = SolvePosition(solver, board, limits, [&](const ProofProgress& progress) {
+		printf("%8.1f s  proving %s  phi %10u delta %10u  nodes %14llu  %9.0f nodes/s  table %5.1f%%\n",
+			progress.seconds, SideName(progress.attacker), progress.phi, progress.delta, (unsigned long long)progress.nodes,
+			progress.seconds > 0 ? (progress.nodes - solver.totalNodes) / progress.seconds : 0.0, 100.0 * progress.tableUsed / progress.tableSize);
+		fflush(stdout);
+
+		auto now = std::chrono::steady_clock::now();
+		if (!options.checkpointPath.empty() && now - lastCheckpoint >= std::chrono::seconds(options.checkpointSeconds)) {
+			if (!SaveProofCheckpoint(solver, board, options.checkpointPath))
+				fprintf(stderr, "     %s\n", options.checkpointPath.c_str());
+			lastCheckpoint = now;
+		}
+	});
+
+	//    ,  -      
+	if (!options.checkpointPath.empty() && !SaveProofCheckpoint(solver, board, options.checkpointPath))
+		fprintf(stderr, "     %s\n", options.checkpointPath.c_str());
+
+	printf("result %s", result.result == RESULT_NONE ? "unknown" : ResultName(result.result));
+	if (result.bestMove >= 0)
+		printf(" bestmove %d %d", result.bestMove % board.size, result.bestMove / board.size);
+	printf(" nodes %llu seconds %.3f\n", (unsigned long long)result.nodes, result.seconds);
+	return result.result == RESULT_NONE ? 3 : 0;
+}
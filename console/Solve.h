@@ -0,0 +1,3 @@
+#pragma once
+
+int SolveMain(int argc, char* argv[]);
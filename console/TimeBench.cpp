@@ -0,0 +1,105 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <random>
+#include <string>
+#include "TimeBench.h"
+#include "Engine.h"
+#include "Histogram.h"
+#include "TimeManager.h"
+
+//       .        
+//  AllocateTime. :     hardMs + TIME_OVERHEAD_MS,  
+// .   1,        
+int TimeBenchMain(int argc, char* argv[]) {
+	int size = 15, winLength = 5, games = 2, clockMs = 3000, incrementMs = 30, randomPlies = 2;
+	unsigned seed = 1;
+	bool valid = argc % 2 == 0;
+	for (int i = 0; i + 1 < argc; i += 2) {
+		std::string key = argv[i];
+		if (key == "--size")
+			size = atoi(argv[i + 1]);
+		else if (key == "--k")
+			winLength = atoi(argv[i + 1]);
+		else if (key == "--games")
+			games = atoi(argv[i + 1]);
+		else if (key == "--clock")
+			clockMs = atoi(argv[i + 1]);
+		else if (key == "--inc")
+			incrementMs = atoi(argv[i + 1]);
+		else if (key == "--random-plies")
+			randomPlies = atoi(argv[i + 1]);
+		else if (key == "--seed")
+			seed = (unsigned)strtoul(argv[i + 1], NULL, 10);
+		else
+			valid = false;
+	}
+	if (!valid || size < 1 || size > MAX_GRID_SIZE || winLength < 1 || winLength > size || games < 1 ||
+		clockMs <= 0 || incrementMs < 0 || randomPlies < 0) {
+		fprintf(stderr, ": time-bench [--size N] [--k N] [--games N] [--clock ] [--inc ]\n"
+			"                  [--random-plies N] [--seed N]\n");
+		return 1;
+	}
+
+	std::unique_ptr<Engine> engine(new Engine());
+	InitEngine(*engine, 16);
+
+	Histogram moveTime, overshoot; //
+	ClearHistogram(moveTime);
+	ClearHistogram(overshoot);
+	int flags = 0, violations = 0;
+	int64_t worstOvershootUs = INT64_MIN;
+
+	for (int game = 0; game < games; game++) {
+		std::mt19937 rng(seed + game);
+		Board board;
+		InitBoard(board, size, winLength);
+		for (int i = 0; i < randomPlies && board.moveCount + 1 < size * size; i++) {
+			int moves[MAX_CELLS];
+			int count = GenerateMoves(board, moves);
+			MakeMove(board, moves[rng() % count]);
+		}
+		ClearEngine(*engine);
+
+		int clocks[2] = { clockMs, clockMs };
+		while (GetResult(board) == RESULT_NONE && board.moveCount < size * size) {
+			int side = board.sideToMove;
+			TimeControl clock = { clocks[side], incrementMs, 0 };
+			TimeBudget budget = AllocateTime(clock, board);
+			SearchLimits limits = { 0, 0, 0, 0, 0 };
+			ApplyTimeBudget(limits, budget);
+
+			auto start = std::chrono::steady_clock::now();
+			SearchResult result = Search(*engine, board, limits, NULL);
+			int64_t elapsedUs = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+
+			RecordValue(moveTime, (uint64_t)elapsedUs);
+			int64_t overUs = elapsedUs - budget.hardMs * 1000LL;
+			worstOvershootUs = std::max(worstOvershootUs, overUs);
+			if (overUs > 0)
+				RecordValue(overshoot, (uint64_t)overUs);
+			if (overUs > TIME_OVERHEAD_MS * 1000LL)
+				violations++;
+
+			clocks[side] -= (int)((elapsedUs + 999) / 1000);
+			if (clocks[side] < 0)
+				flags++;
+			clocks[side] += incrementMs;
+
+			if (result.bestMove < 0)
+				break;
+			MakeMove(board, result.bestMove);
+		}
+		printf("game %d: %s after %d moves, clocks x %d ms o %d ms\n", game + 1, ResultName(GetResult(board)),
+			board.moveCount, clocks[SIDE_X], clocks[SIDE_O]);
+	}
+
+	printf("%s\n", FormatHistogram(moveTime, "move time", 1e-3, "ms").c_str());
+	printf("%s\n", FormatHistogram(overshoot, "past hard limit", 1e-3, "ms").c_str());
+	printf("worst finish vs hard limit %+.3f ms (allowed +%d ms)\n", worstOvershootUs / 1000.0, TIME_OVERHEAD_MS);
+	printf("flag falls %d, deadline violations %d: %s\n", flags, violations, flags || violations ? "FAILED" : "ok");
+	return flags || violations ? 1 : 0;
+}
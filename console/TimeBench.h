@@ -0,0 +1,3 @@
+#pragma once
+
+int TimeBenchMain(int argc, char* argv[]);
@@ -0,0 +1,298 @@
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <sstream>
+#include <thread>
+#include "Tournament.h"
+#include "Engine.h"
+#include "GameLog.h"
+#include "Metrics.h"
+
+//  ,  "radius=1,depth=4,hash=8"
+struct TournamentEngine {
+	std::string name;
+	int candidateRadius;
+	int depth;
+	int tableMegabytes;
+	bool threatSearch;
+	bool patternEval;
+	bool useBook; //     --book
+	bool useNetwork; //  --network
+	int solveEmpties; //      , 0 - 
+};
+
+struct TournamentOptions {
+	TournamentEngine engines[2];
+	int games;
+	int threads;
+	int size;
+	int winLength;
+	int randomPlies; //   ,    
+	uint64_t nodes; //    
+	int moveTimeMs; //    
+	unsigned seed;
+	std::string logPath;
+	std::string bookPath;
+	std::string networkPath;
+};
+
+static bool ParseEngineSpec(const std::string& spec, TournamentEngine& engine) {
+	engine.name = spec;
+	engine.candidateRadius = 2;
+	engine.depth = 0;
+	engine.tableMegabytes = 4;
+	engine.threatSearch = true;
+	engine.patternEval = true;
+	engine.useBook = false;
+	engine.useNetwork = false;
+	engine.solveEmpties = DEFAULT_SOLVE_EMPTIES;
+
+	std::istringstream in(spec);
+	std::string item;
+	while (std::getline(in, item, ',')) {
+		size_t equals = item.find('=');
+		if (equals == std::string::npos)
+			return false;
+		std::string key = item.substr(0, equals);
+		int value = atoi(item.c_str() + equals + 1);
+		if (key == "radius")
+			engine.candidateRadius = value;
+		else if (key == "depth")
+			engine.depth = value;
+		else if (key == "hash")
+			engine.tableMegabytes = value;
+		else if (key == "threats")
+			engine.threatSearch = value != 0;
+		else if (key == "eval")
+			engine.patternEval = value != 0;
+		else if (key == "book")
+			engine.useBook = value != 0;
+		else if (key == "nnue")
+			engine.useNetwork = value != 0;
+		else if (key == "solve")
+			engine.solveEmpties = value;
+		else
+			return false;
+	}
+	return engine.tableMegabytes > 0;
+}
+
+//       
+static void PlayOpening(Board& board, const TournamentOptions& options, int opening) {
+	std::mt19937 rng(options.seed + opening);
+	InitBoard(board, options.size, options.winLength);
+	for (int i = 0; i < options.randomPlies; i++) {
+		int moves[MAX_CELLS];
+		int count = GenerateMoves(board, moves);
+		//   :     
+		int candidates = 0;
+		for (int j = 0; j < count; j++) {
+			if (!IsWinningMove(board, moves[j], board.sideToMove))
+				moves[candidates++] = moves[j];
+		}
+		if (candidates == 0 || board.moveCount + 1 >= board.size * board.size)
+			break;
+		MakeMove(board, moves[rng() % candidates]);
+	}
+}
+
+// . firstEngine -  ,   X
+static int PlayGame(Engine* engines[2], const TournamentOptions& options, Board& board, int firstEngine) {
+	int result;
+	while ((result = GetResult(board)) == RESULT_NONE) {
+		int player = board.sideToMove == SIDE_X ? firstEngine : 1 - firstEngine;
+		SearchLimits limits = { options.engines[player].depth, options.nodes, options.moveTimeMs, 0, 0 };
+		SearchResult search = Search(*engines[player], board, limits, NULL);
+		if (search.bestMove < 0)
+			break;
+		MakeMove(board, search.bestMove);
+		CountMetric(METRIC_MOVES);
+	}
+	return result;
+}
+
+//         95%  
+static double EloFromScore(double score) {
+	if (score <= 0.0)
+		return -INFINITY;
+	if (score >= 1.0)
+		return INFINITY;
+	return -400.0 * log10(1.0 / score - 1.0);
+}
+
+static void PrintElo(int wins, int draws, int losses) {
+	int games = wins + draws + losses;
+	double score = (wins + 0.5 * draws) / games;
+	double variance = (wins * pow(1.0 - score, 2) + draws * pow(0.5 - score, 2) + losses * pow(score, 2)) / games;
+	double margin = 1.96 * sqrt(variance / games);
+
+	printf("score            %.1f%%\n", score * 100.0);
+	printf("elo              %+.1f [%+.1f, %+.1f] (95%%)\n", EloFromScore(score), EloFromScore(score - margin), EloFromScore(score + margin));
+}
+
+static bool ParseTournamentOptions(int argc, char* argv[], TournamentOptions& options) {
+	int engineCount = 0;
+	options.games = 100;
+	options.threads = (int)std::thread::hardware_concurrency();
+	options.size = 3;
+	options.winLength = 3;
+	options.randomPlies = 2;
+	options.nodes = 0;
+	options.moveTimeMs = 0;
+	options.seed = 1;
+	bool limited = false;
+
+	for (int i = 0; i + 1 < argc; i += 2) {
+		std::string key = argv[i], value = argv[i + 1];
+		if (key == "--engine") {
+			if (engineCount == 2 || !ParseEngineSpec(value, options.engines[engineCount]))
+				return false;
+			engineCount++;
+		}
+		else if (key == "--games")
+			options.games = atoi(value.c_str());
+		else if (key == "--threads")
+			options.threads = atoi(value.c_str());
+		else if (key == "--size")
+			options.size = atoi(value.c_str());
+		else if (key == "--k")
+			options.winLength = atoi(value.c_str());
+		else if (key == "--random-plies")
+			options.randomPlies = atoi(value.c_str());
+		else if (key == "--nodes") {
+			options.nodes = strtoull(value.c_str(), NULL, 10);
+			limited = true;
+		}
+		else if (key == "--movetime") {
+			options.moveTimeMs = atoi(value.c_str());
+			limited = true;
+		}
+		else if (key == "--seed")
+			options.seed = (unsigned)strtoul(value.c_str(), NULL, 10);
+		else if (key == "--log")
+			options.logPath = value;
+		else if (key == "--book")
+			options.bookPath = value;
+		else if (key == "--network")
+			options.networkPath = value;
+		else
+			return false;
+	}
+
+	if (argc % 2 != 0 || engineCount != 2)
+		return false;
+	if (options.threads < 1)
+		options.threads = 1;
+	if (!limited)
+		options.nodes = 10000; //       
+	if ((options.engines[0].useBook || options.engines[1].useBook) && options.bookPath.empty())
+		return false;
+	if ((options.engines[0].useNetwork || options.engines[1].useNetwork) && options.networkPath.empty())
+		return false;
+	return options.games > 0 && options.size >= 1 && options.size <= MAX_GRID_SIZE &&
+		options.winLength >= 1 && options.winLength <= options.size && options.randomPlies >= 0;
+}
+
+int TournamentMain(int argc, char* argv[]) {
+	TournamentOptions options;
+	if (!ParseTournamentOptions(argc, argv, options)) {
+		fprintf(stderr, ": tournament --engine  --engine  [--games N] [--threads N] [--size N] [--k N]\n"
+			"                  [--nodes N | --movetime ] [--random-plies N] [--seed N] [--log ] [--book ]\n"
+			"                  [--network ]\n"
+			" : radius=N,depth=N,hash=,threats=0|1,eval=0|1,book=0|1,nnue=0|1,solve=N\n");
+		return 1;
+	}
+
+	//     :   
+	OpeningBook book;
+	bool hasBook = !options.bookPath.empty();
+	if (hasBook && !OpenOpeningBook(options.bookPath, book)) {
+		fprintf(stderr, "    %s\n", options.bookPath.c_str());
+		return 1;
+	}
+
+	std::unique_ptr<Network> network(new Network());
+	if (!options.networkPath.empty() && !LoadNetwork(options.networkPath, *network)) {
+		fprintf(stderr, "    %s\n", options.networkPath.c_str());
+		return 1;
+	}
+
+	GameLogWriter log;
+	bool logging = !options.logPath.empty() && OpenGameLogWriter(options.logPath, log);
+	std::mutex logMutex;
+
+	std::atomic<int> nextGame(0);
+	std::atomic<int> wins(0), draws(0), losses(0); //    
+
+	//        
+	auto worker = [&]() {
+		Engine first, second;
+		InitEngine(first, options.engines[0].tableMegabytes);
+		InitEngine(second, options.engines[1].tableMegabytes);
+		first.candidateRadius = options.engines[0].candidateRadius;
+		second.candidateRadius = options.engines[1].candidateRadius;
+		first.threatSearch = options.engines[0].threatSearch;
+		second.threatSearch = options.engines[1].threatSearch;
+		first.solveEmpties = options.engines[0].solveEmpties;
+		second.solveEmpties = options.engines[1].solveEmpties;
+		first.patternEval = options.engines[0].patternEval;
+		second.patternEval = options.engines[1].patternEval;
+		first.book = options.engines[0].useBook ? &book : NULL;
+		second.book = options.engines[1].useBook ? &book : NULL;
+		first.network = options.engines[0].useNetwork ? network.get() : NULL;
+		second.network = options.engines[1].useNetwork ? network.get() : NULL;
+		Engine* engines[2] = { &first, &second };
+
+		Board board;
+		int game;
+		while ((game = nextGame++) < options.games) {
+			// ׸      X,  -  O    
+			int firstEngine = game % 2;
+			PlayOpening(board, options, game / 2);
+			ClearEngine(first);
+			ClearEngine(second);
+			int result = PlayGame(engines, options, board, firstEngine);
+
+			int winner = result == RESULT_X_WIN ? firstEngine : (result == RESULT_O_WIN ? 1 - firstEngine : -1);
+			if (winner == 0)
+				wins++;
+			else if (winner == 1)
+				losses++;
+			else
+				draws++;
+
+			if (logging) {
+				std::lock_guard<std::mutex> lock(logMutex);
+				WriteGame(log, board, result);
+			}
+		}
+	};
+
+	auto start = std::chrono::steady_clock::now();
+	std::vector<std::thread> threads;
+	for (int i = 0; i < options.threads; i++)
+		threads.emplace_back(worker);
+	for (std::thread& thread : threads)
+		thread.join();
+	double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+	if (logging) {
+		CloseGameLogWriter(log);
+		if (log.failed)
+			fprintf(stderr, " %s   \n", options.logPath.c_str());
+	}
+	if (hasBook)
+		CloseOpeningBook(book);
+
+	printf("engines          %s vs %s\n", options.engines[0].name.c_str(), options.engines[1].name.c_str());
+	printf("games            %d (%d threads)\n", options.games, options.threads);
+	printf("wins/draws/losses %d/%d/%d\n", wins.load(), draws.load(), losses.load());
+	PrintElo(wins, draws, losses);
+	printf("games/s          %.1f\n", options.games / seconds);
+	return 0;
+}
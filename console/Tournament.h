@@ -0,0 +1,3 @@
+#pragma once
+
+int TournamentMain(int argc, char* argv[]);
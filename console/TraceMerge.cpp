@@ -0,0 +1,44 @@
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include "json.hpp"
+#include "TraceMerge.h"
+using json = nlohmann::json;
+
+//    (trace-<pid>.json)   .    
+//   QueryPerformanceCounter,       
+int TraceMergeMain(int argc, char* argv[]) {
+	if (argc < 2) {
+		fprintf(stderr, ": trace-merge < > <> [ ...]\n");
+		return 1;
+	}
+
+	json merged = { { "displayTimeUnit", "ns" }, { "traceEvents", json::array() } };
+	for (int i = 1; i < argc; i++) {
+		std::ifstream file(argv[i]);
+		json trace;
+		try {
+			file >> trace;
+		}
+		catch (...) {
+			fprintf(stderr, "   %s\n", argv[i]);
+			return 1;
+		}
+
+		if (!trace.contains("traceEvents") || !trace["traceEvents"].is_array()) {
+			fprintf(stderr, " %s  traceEvents\n", argv[i]);
+			return 1;
+		}
+		for (json& event : trace["traceEvents"])
+			merged["traceEvents"].push_back(std::move(event));
+	}
+
+	std::ofstream out(argv[0]);
+	out << merged.dump() << "\n";
+	if (!out) {
+		fprintf(stderr, "   %s\n", argv[0]);
+		return 1;
+	}
+	printf("%zu   %d \n", merged["traceEvents"].size(), argc - 1);
+	return 0;
+}
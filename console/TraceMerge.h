@@ -0,0 +1,3 @@
+#pragma once
+
+int TraceMergeMain(int argc, char* argv[]);
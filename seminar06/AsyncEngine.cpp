@@ -0,0 +1,149 @@
+#include <memory>
+#include "AsyncEngine.h"
+#include "Metrics.h"
+
+//      .      
+static void AsyncWorker(AsyncEngine* async) {
+	std::unique_lock<std::mutex> lock(async->mutex);
+	for (;;) {
+		async->wake.wait(lock, [async]() { return async->quit || !async->jobs.empty(); });
+		if (async->jobs.empty())
+			break;
+
+		AsyncSearchJob job = std::move(async->jobs.front());
+		async->jobs.pop_front();
+		AsyncSearchDone done = { job.id, job.id < async->cancelledBelow, { -1, 0, 0, 0, 0.0, -1 } };
+		if (!done.cancelled) {
+			// stop   :       
+			async->runningId = job.id;
+			async->engine.stop = false;
+			async->engine.ponder = job.ponder && job.id == async->ponderId;
+			lock.unlock();
+			done.result = Search(async->engine, job.board, job.limits, job.onInfo);
+			lock.lock();
+			async->runningId = 0;
+
+			// ,    ,      
+			if (job.ponder)
+				async->wake.wait(lock, [async, &job]() { return async->ponderId != job.id || job.id < async->cancelledBelow; });
+			async->engine.ponder = false;
+			done.cancelled = job.id < async->cancelledBelow;
+		}
+
+		lock.unlock();
+		if (job.onDone)
+			job.onDone(done);
+		lock.lock();
+	}
+}
+
+void StartAsyncEngine(AsyncEngine& async) {
+	async.nextId = 1;
+	async.cancelledBelow = 0;
+	async.runningId = 0;
+	async.ponderId = 0;
+	async.ponders = 0;
+	async.ponderHits = 0;
+	async.quit = false;
+	async.thread = std::thread(AsyncWorker, &async);
+}
+
+void StopAsyncEngine(AsyncEngine& async) {
+	{
+		std::lock_guard<std::mutex> lock(async.mutex);
+		async.quit = true;
+		async.cancelledBelow = async.nextId;
+		async.ponderId = 0;
+		if (async.runningId)
+			async.engine.stop = true;
+	}
+	async.wake.notify_one();
+	if (async.thread.joinable())
+		async.thread.join();
+}
+
+static uint64_t QueueSearch(AsyncEngine& async, const Board& board, const SearchLimits& limits,
+	const AsyncSearchCallback& onDone, const SearchInfoCallback& onInfo, bool ponder) {
+	uint64_t id;
+	{
+		std::lock_guard<std::mutex> lock(async.mutex);
+		id = async.nextId++;
+		async.cancelledBelow = id;
+		async.ponderId = ponder ? id : 0;
+		if (async.runningId)
+			async.engine.stop = true;
+		if (ponder)
+			async.ponders++;
+
+		AsyncSearchJob job;
+		job.id = id;
+		job.board = board;
+		job.limits = limits;
+		job.onInfo = onInfo;
+		job.onDone = onDone;
+		job.ponder = ponder;
+		async.jobs.push_back(std::move(job));
+	}
+	async.wake.notify_one();
+	if (ponder)
+		CountMetric(METRIC_PONDERS);
+	return id;
+}
+
+uint64_t StartSearch(AsyncEngine& async, const Board& board, const SearchLimits& limits,
+	const AsyncSearchCallback& onDone, const SearchInfoCallback& onInfo) {
+	return QueueSearch(async, board, limits, onDone, onInfo, false);
+}
+
+uint64_t StartPonder(AsyncEngine& async, const Board& board, const SearchLimits& limits,
+	const AsyncSearchCallback& onDone, const SearchInfoCallback& onInfo) {
+	return QueueSearch(async, board, limits, onDone, onInfo, true);
+}
+
+bool PonderHit(AsyncEngine& async) {
+	{
+		std::lock_guard<std::mutex> lock(async.mutex);
+		if (!async.ponderId)
+			return false;
+		async.ponderId = 0;
+		async.ponderHits++;
+		async.engine.ponder = false;
+	}
+	async.wake.notify_one();
+	CountMetric(METRIC_PONDER_HITS);
+	return true;
+}
+
+std::future<AsyncSearchDone> SearchAsync(AsyncEngine& async, const Board& board, const SearchLimits& limits) {
+	std::shared_ptr<std::promise<AsyncSearchDone>> promise = std::make_shared<std::promise<AsyncSearchDone>>();
+	std::future<AsyncSearchDone> future = promise->get_future();
+	StartSearch(async, board, limits, [promise](const AsyncSearchDone& done) {
+		promise->set_value(done);
+	});
+	return future;
+}
+
+void CancelSearch(AsyncEngine& async) {
+	{
+		std::lock_guard<std::mutex> lock(async.mutex);
+		async.cancelledBelow = async.nextId;
+		async.ponderId = 0;
+		if (async.runningId)
+			async.engine.stop = true;
+	}
+	async.wake.notify_one();
+}
+
+bool IsSearching(AsyncEngine& async) {
+	std::lock_guard<std::mutex> lock(async.mutex);
+	return async.runningId != 0 || !async.jobs.empty();
+}
+
+PonderStats ReadPonderStats(AsyncEngine& async) {
+	std::lock_guard<std::mutex> lock(async.mutex);
+	PonderStats stats;
+	stats.ponders = async.ponders;
+	stats.hits = async.ponderHits;
+	stats.hitRate = stats.ponders ? (double)stats.hits / stats.ponders : 0.0;
+	return stats;
+}
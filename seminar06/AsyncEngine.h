@@ -0,0 +1,69 @@
+#pragma once
+#include <condition_variable>
+#include <deque>
+#include <future>
+#include <mutex>
+#include <thread>
+#include "Engine.h"
+
+//   :         ,
+//          std::future.
+//    :   ,    Engine::stop.
+//
+// (ponder):   ,        .
+//    , PonderHit  ,    ,   
+//   .    ,     
+struct AsyncSearchDone {
+	uint64_t id; //  StartSearch
+	bool cancelled; // , result -      
+	SearchResult result;
+};
+
+typedef std::function<void(const AsyncSearchDone&)> AsyncSearchCallback;
+
+struct AsyncSearchJob {
+	uint64_t id;
+	Board board;
+	SearchLimits limits;
+	SearchInfoCallback onInfo; //   
+	bool ponder;
+	AsyncSearchCallback onDone; //         
+};
+
+struct AsyncEngine {
+	Engine engine; //     ,   StartAsyncEngine
+
+	std::mutex mutex;
+	std::condition_variable wake;
+	std::deque<AsyncSearchJob> jobs;
+	uint64_t nextId;
+	uint64_t cancelledBelow; //    
+	uint64_t runningId; //0 -  
+	uint64_t ponderId; //,   , 0 - 
+	uint64_t ponders;
+	uint64_t ponderHits;
+	bool quit;
+	std::thread thread;
+};
+
+void StartAsyncEngine(AsyncEngine& async);
+//  ,       
+void StopAsyncEngine(AsyncEngine& async);
+uint64_t StartSearch(AsyncEngine& async, const Board& board, const SearchLimits& limits,
+	const AsyncSearchCallback& onDone, const SearchInfoCallback& onInfo = SearchInfoCallback());
+std::future<AsyncSearchDone> SearchAsync(AsyncEngine& async, const Board& board, const SearchLimits& limits);
+//     PonderHit  
+uint64_t StartPonder(AsyncEngine& async, const Board& board, const SearchLimits& limits,
+	const AsyncSearchCallback& onDone, const SearchInfoCallback& onInfo = SearchInfoCallback());
+//false,     -    
+bool PonderHit(AsyncEngine& async);
+void CancelSearch(AsyncEngine& async);
+bool IsSearching(AsyncEngine& async);
+
+struct PonderStats {
+	uint64_t ponders;
+	uint64_t hits;
+	double hitRate;
+};
+
+PonderStats ReadPonderStats(AsyncEngine& async);
@@ -0,0 +1,264 @@
+#include <algorithm>
+#include <array>
+#include <utility>
+#include "Board.h"
+#include "WinLines.h"
+
+//       .  ,
+//     
+static uint64_t zobristKeys[2][MAX_CELLS];
+
+static struct ZobristInit {
+	ZobristInit() {
+		uint64_t state = 0x9E3779B97F4A7C15ULL;
+		for (int side = 0; side < 2; side++) {
+			for (int cell = 0; cell < MAX_CELLS; cell++) {
+				// splitmix64
+				uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+				z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+				z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+				zobristKeys[side][cell] = z ^ (z >> 31);
+			}
+		}
+	}
+} zobristInit;
+
+void InitBoard(Board& board, int size, int winLength) {
+	board.size = size;
+	board.winLength = winLength;
+	ClearBitboard(board.stones[SIDE_X]);
+	ClearBitboard(board.stones[SIDE_O]);
+	board.sideToMove = SIDE_X;
+	board.moveCount = 0;
+	board.hash = 0;
+}
+
+bool IsEmptyCell(const Board& board, int cell) {
+	return !TestBit(board.stones[SIDE_X], cell) && !TestBit(board.stones[SIDE_O], cell);
+}
+
+//  :    
+void MakeMove(Board& board, int cell) {
+	SetBit(board.stones[board.sideToMove], cell);
+	board.hash ^= zobristKeys[board.sideToMove][cell];
+	board.moves[board.moveCount++] = (uint16_t)cell;
+	board.sideToMove ^= 1;
+}
+
+void UndoMove(Board& board) {
+	board.sideToMove ^= 1;
+	int cell = board.moves[--board.moveCount];
+	ResetBit(board.stones[board.sideToMove], cell);
+	board.hash ^= zobristKeys[board.sideToMove][cell];
+}
+
+//      ,     :
+//     4k,    AND  
+template <int SIZE, bool SINGLE_WORD = (SIZE * SIZE <= 64)>
+struct LineKernel {
+	template <int K>
+	static bool IsWinningMove(uint64_t stones, int cell) {
+		const WinLineTable<SIZE, K>& table = WinLines<SIZE, K>::table;
+		stones |= 1ULL << cell;
+		for (int i = 0; i < table.cellLineCount[cell]; i++) {
+			uint64_t mask = table.masks[table.cellLines[cell][i]][0];
+			if ((stones & mask) == mask)
+				return true;
+		}
+		return false;
+	}
+
+	//false,    k      
+	static bool TryIsWinningMove(const Board& board, int cell, int side, bool& win) {
+		uint64_t stones = board.stones[side].words[0];
+		switch (board.winLength) {
+		case 3: win = IsWinningMove<3>(stones, cell); return true;
+		case 4: win = IsWinningMove<4>(stones, cell); return true;
+		case 5: win = IsWinningMove<5>(stones, cell); return true;
+		default: return false;
+		}
+	}
+};
+
+//        
+template <int SIZE>
+struct LineKernel<SIZE, false> {
+	static bool TryIsWinningMove(const Board&, int, int, bool&) {
+		return false;
+	}
+};
+
+//    .    ,     
+//   - ,   3x3       
+template <int SIZE>
+struct BoardKernel {
+	static const int CELLS = SIZE * SIZE;
+	static const int WORDS = (CELLS + 63) / 64;
+
+	//        
+	static int CountRay(const Bitboard& stones, int x, int y, int dx, int dy) {
+		int count = 0;
+		x += dx;
+		y += dy;
+		while (x >= 0 && x < SIZE && y >= 0 && y < SIZE && TestBit(stones, y * SIZE + x)) {
+			count++;
+			x += dx;
+			y += dy;
+		}
+		return count;
+	}
+
+	static bool IsWinningMove(const Board& board, int cell, int side) {
+		bool win;
+		if (LineKernel<SIZE>::TryIsWinningMove(board, cell, side, win))
+			return win;
+
+		static const int directions[4][2] = { { 1, 0 }, { 0, 1 }, { 1, 1 }, { 1, -1 } };
+
+		const Bitboard& stones = board.stones[side];
+		int x = cell % SIZE;
+		int y = cell / SIZE;
+		for (int i = 0; i < 4; i++) {
+			int dx = directions[i][0], dy = directions[i][1];
+			if (1 + CountRay(stones, x, y, dx, dy) + CountRay(stones, x, y, -dx, -dy) >= board.winLength)
+				return true;
+		}
+		return false;
+	}
+
+	static int GenerateMoves(const Board& board, int* moves) {
+		int count = 0;
+		for (int word = 0; word < WORDS; word++) {
+			uint64_t empty = ~(board.stones[SIDE_X].words[word] | board.stones[SIDE_O].words[word]);
+			if (CELLS - word * 64 < 64)
+				empty &= (1ULL << (CELLS - word * 64)) - 1;
+			while (empty) {
+				moves[count++] = word * 64 + LowestBit(empty);
+				empty &= empty - 1;
+			}
+		}
+		return count;
+	}
+};
+
+//      1  MAX_GRID_SIZE,   board.size   
+struct BoardKernels {
+	bool (*isWinningMove)(const Board& board, int cell, int side);
+	int (*generateMoves)(const Board& board, int* moves);
+};
+
+template <size_t... SIZES>
+static constexpr std::array<BoardKernels, sizeof...(SIZES)> MakeBoardKernels(std::index_sequence<SIZES...>) {
+	return { { { BoardKernel<SIZES + 1>::IsWinningMove, BoardKernel<SIZES + 1>::GenerateMoves }... } };
+}
+
+static constexpr std::array<BoardKernels, MAX_GRID_SIZE> boardKernels = MakeBoardKernels(std::make_index_sequence<MAX_GRID_SIZE>());
+
+//      cell   winLength 
+bool IsWinningMove(const Board& board, int cell, int side) {
+	return boardKernels[board.size - 1].isWinningMove(board, cell, side);
+}
+
+//    ,     
+int GetResult(const Board& board) {
+	if (board.moveCount > 0) {
+		int lastSide = board.sideToMove ^ 1;
+		if (IsWinningMove(board, board.moves[board.moveCount - 1], lastSide))
+			return lastSide == SIDE_X ? RESULT_X_WIN : RESULT_O_WIN;
+	}
+	if (board.moveCount == board.size * board.size)
+		return RESULT_DRAW;
+	return RESULT_NONE;
+}
+
+//  .   
+int GenerateMoves(const Board& board, int* moves) {
+	return boardKernels[board.size - 1].generateMoves(board, moves);
+}
+
+//    radius     .    - 
+int GenerateNearbyMoves(const Board& board, int radius, int* moves) {
+	if (board.moveCount == 0) {
+		moves[0] = (board.size / 2) * board.size + board.size / 2;
+		return 1;
+	}
+
+	bool near[MAX_CELLS] = { false };
+	for (int i = 0; i < board.moveCount; i++) {
+		int x = board.moves[i] % board.size, y = board.moves[i] / board.size;
+		for (int ny = std::max(0, y - radius); ny <= std::min(board.size - 1, y + radius); ny++) {
+			for (int nx = std::max(0, x - radius); nx <= std::min(board.size - 1, x + radius); nx++)
+				near[ny * board.size + nx] = true;
+		}
+	}
+
+	int count = 0;
+	for (int cell = 0; cell < board.size * board.size; cell++) {
+		if (near[cell] && IsEmptyCell(board, cell))
+			moves[count++] = cell;
+	}
+	return count;
+}
+
+const char* ResultName(int result) {
+	switch (result) {
+	case RESULT_X_WIN: return "x";
+	case RESULT_O_WIN: return "o";
+	case RESULT_DRAW: return "draw";
+	default: return "none";
+	}
+}
+
+// : X, O    
+std::string CellsToString(const Board& board) {
+	std::string cells;
+	for (int cell = 0; cell < board.size * board.size; cell++) {
+		if (TestBit(board.stones[SIDE_X], cell))
+			cells += 'X';
+		else if (TestBit(board.stones[SIDE_O], cell))
+			cells += 'O';
+		else
+			cells += '.';
+	}
+	return cells;
+}
+
+int TransformCell(int cell, int size, int symmetry) {
+	int x = cell % size, y = cell / size, last = size - 1;
+	if (symmetry & 1)
+		x = last - x;
+	if (symmetry & 2)
+		y = last - y;
+	if (symmetry & 4)
+		std::swap(x, y);
+	return y * size + x;
+}
+
+//   ,    -      
+int InverseTransformCell(int cell, int size, int symmetry) {
+	int x = cell % size, y = cell / size, last = size - 1;
+	if (symmetry & 4)
+		std::swap(x, y);
+	if (symmetry & 1)
+		x = last - x;
+	if (symmetry & 2)
+		y = last - y;
+	return y * size + x;
+}
+
+//    :    ,     
+uint64_t CanonicalKey(const Board& board, int& symmetry) {
+	uint64_t keys[BOARD_SYMMETRIES] = {};
+	for (int i = 0; i < board.moveCount; i++) {
+		int side = i & 1 ? SIDE_O : SIDE_X;
+		for (int s = 0; s < BOARD_SYMMETRIES; s++)
+			keys[s] ^= zobristKeys[side][TransformCell(board.moves[i], board.size, s)];
+	}
+
+	symmetry = 0;
+	for (int s = 1; s < BOARD_SYMMETRIES; s++) {
+		if (keys[s] < keys[symmetry])
+			symmetry = s;
+	}
+	return keys[symmetry];
+}
@@ -0,0 +1,117 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+const int MAX_GRID_SIZE = 19; //  ,       
+const int MAX_CELLS = MAX_GRID_SIZE * MAX_GRID_SIZE; //  
+const int BITBOARD_WORDS = (MAX_CELLS + 63) / 64; // 64-    
+
+//
+const int SIDE_X = 0;
+const int SIDE_O = 1;
+
+// :    ,   = y * gridSize + x
+struct Bitboard {
+	uint64_t words[BITBOARD_WORDS];
+};
+
+inline void ClearBitboard(Bitboard& bb) {
+	for (int i = 0; i < BITBOARD_WORDS; i++)
+		bb.words[i] = 0;
+}
+
+inline bool TestBit(const Bitboard& bb, int cell) {
+	return (bb.words[cell >> 6] >> (cell & 63)) & 1;
+}
+
+inline void SetBit(Bitboard& bb, int cell) {
+	bb.words[cell >> 6] |= 1ULL << (cell & 63);
+}
+
+inline void ResetBit(Bitboard& bb, int cell) {
+	bb.words[cell >> 6] &= ~(1ULL << (cell & 63));
+}
+
+//   , x    
+inline int LowestBit(uint64_t x) {
+#if defined(_MSC_VER) && defined(_WIN64)
+	unsigned long index;
+	_BitScanForward64(&index, x);
+	return (int)index;
+#elif defined(_MSC_VER)
+	unsigned long index;
+	if (_BitScanForward(&index, (unsigned long)x))
+		return (int)index;
+	_BitScanForward(&index, (unsigned long)(x >> 32));
+	return (int)index + 32;
+#else
+	return __builtin_ctzll(x);
+#endif
+}
+
+//  
+inline int PopCount(uint64_t x) {
+#if defined(_MSC_VER) && defined(_WIN64)
+	return (int)__popcnt64(x);
+#elif defined(_MSC_VER)
+	return (int)(__popcnt((unsigned)x) + __popcnt((unsigned)(x >> 32)));
+#else
+	return __builtin_popcountll(x);
+#endif
+}
+
+//   :       
+typedef uint16_t MoveEntry;
+const MoveEntry MOVE_SIDE_O = 0x8000;
+
+inline MoveEntry PackMove(int cell, int side) {
+	return (MoveEntry)(cell | (side == SIDE_O ? MOVE_SIDE_O : 0));
+}
+
+inline int MoveCell(MoveEntry move) {
+	return move & ~MOVE_SIDE_O;
+}
+
+inline int MoveSide(MoveEntry move) {
+	return (move & MOVE_SIDE_O) ? SIDE_O : SIDE_X;
+}
+
+// 
+const int RESULT_NONE = 0; //  
+const int RESULT_X_WIN = 1;
+const int RESULT_O_WIN = 2;
+const int RESULT_DRAW = 3;
+
+//   :    ,   X
+struct Board {
+	int size; // 
+	int winLength; //       (k)
+	Bitboard stones[2]; // X  O
+	int sideToMove;
+	int moveCount;
+	uint16_t moves[MAX_CELLS]; //   
+	uint64_t hash; //  ,    
+};
+
+void InitBoard(Board& board, int size, int winLength);
+bool IsEmptyCell(const Board& board, int cell);
+void MakeMove(Board& board, int cell);
+void UndoMove(Board& board);
+bool IsWinningMove(const Board& board, int cell, int side);
+int GetResult(const Board& board);
+int GenerateMoves(const Board& board, int* moves);
+int GenerateNearbyMoves(const Board& board, int radius, int* moves);
+const char* ResultName(int result);
+std::string CellsToString(const Board& board);
+
+//  :   x ( 1)   y ( 2),   ( 4)
+const int BOARD_SYMMETRIES = 8;
+int TransformCell(int cell, int size, int symmetry);
+int InverseTransformCell(int cell, int size, int symmetry);
+
+//,     :     .
+//symmetry - ,     (  )
+uint64_t CanonicalKey(const Board& board, int& symmetry);
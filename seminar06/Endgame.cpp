@@ -0,0 +1,162 @@
+#include <algorithm>
+#include "Endgame.h"
+
+const uint8_t ENDGAME_EXACT = 0;
+const uint8_t ENDGAME_LOWER = 1;
+const uint8_t ENDGAME_UPPER = 2;
+
+void InitEndgameSolver(EndgameSolver& solver) {
+	solver.table.assign(ENDGAME_TABLE_ENTRIES, EndgameEntry());
+	solver.tableMask = ENDGAME_TABLE_ENTRIES - 1;
+	ClearBitboard(solver.cells);
+	solver.nodes = 0;
+	solver.nodeLimit = 0;
+	solver.shouldStop = NULL;
+	solver.aborted = false;
+}
+
+static bool ShouldAbort(EndgameSolver& solver) {
+	if (solver.nodeLimit && solver.nodes >= solver.nodeLimit)
+		solver.aborted = true;
+	else if ((solver.nodes & (ENDGAME_STOP_CHECK_INTERVAL - 1)) == 0 && *solver.shouldStop && (*solver.shouldStop)())
+		solver.aborted = true;
+	return solver.aborted;
+}
+
+//   .   :    
+static int SolveNode(EndgameSolver& solver, Board& board, int alpha, int beta) {
+	solver.nodes++;
+	if (ShouldAbort(solver))
+		return 0;
+
+	int cells = board.size * board.size;
+	int words = (cells + 63) / 64;
+	int side = board.sideToMove;
+	Bitboard empty;
+	for (int w = 0; w < words; w++)
+		empty.words[w] = solver.cells.words[w] & ~(board.stones[SIDE_X].words[w] | board.stones[SIDE_O].words[w]);
+
+	//      ,   
+	int threat = -1, threats = 0;
+	for (int w = 0; w < words; w++) {
+		for (uint64_t bits = empty.words[w]; bits; bits &= bits - 1) {
+			int cell = w * 64 + LowestBit(bits);
+			if (IsWinningMove(board, cell, side))
+				return 1;
+			if (IsWinningMove(board, cell, 1 - side)) {
+				threat = cell;
+				threats++;
+			}
+		}
+	}
+	if (threats > 1)
+		return -1;
+	if (board.moveCount + 1 == cells)
+		return 0; //     
+
+	EndgameEntry& entry = solver.table[board.hash & solver.tableMask];
+	int ttMove = -1;
+	if (entry.key == board.hash) {
+		if (entry.bound == ENDGAME_EXACT ||
+			(entry.bound == ENDGAME_LOWER && entry.value >= beta) ||
+			(entry.bound == ENDGAME_UPPER && entry.value <= alpha))
+			return entry.value;
+		if (entry.move >= 0 && TestBit(empty, entry.move))
+			ttMove = entry.move;
+	}
+
+	int originalAlpha = alpha;
+	int best = -2;
+	int bestMove = -1;
+	auto visit = [&](int cell) {
+		MakeMove(board, cell);
+		int value = -SolveNode(solver, board, -beta, -alpha);
+		UndoMove(board);
+		if (solver.aborted)
+			return true;
+		if (value > best) {
+			best = value;
+			bestMove = cell;
+			if (value > alpha)
+				alpha = value;
+		}
+		return alpha >= beta;
+	};
+
+	if (threat >= 0)
+		visit(threat);
+	else if (ttMove < 0 || !visit(ttMove)) {
+		bool cut = false;
+		for (int w = 0; w < words && !cut; w++) {
+			for (uint64_t bits = empty.words[w]; bits && !cut; bits &= bits - 1) {
+				int cell = w * 64 + LowestBit(bits);
+				if (cell != ttMove)
+					cut = visit(cell);
+			}
+		}
+	}
+	if (solver.aborted)
+		return 0;
+
+	entry.key = board.hash;
+	entry.move = (int16_t)bestMove;
+	entry.value = (int8_t)best;
+	entry.bound = best <= originalAlpha ? ENDGAME_UPPER : (best >= beta ? ENDGAME_LOWER : ENDGAME_EXACT);
+	return best;
+}
+
+EndgameResult SolveEndgame(EndgameSolver& solver, const Board& rootBoard, uint64_t nodeLimit,
+	const EndgameStopCallback& shouldStop) {
+	EndgameResult result = { true, 0, -1, 0 };
+	solver.nodes = 0;
+	solver.nodeLimit = nodeLimit;
+	solver.shouldStop = &shouldStop;
+	solver.aborted = false;
+	int cells = rootBoard.size * rootBoard.size;
+	ClearBitboard(solver.cells);
+	for (int cell = 0; cell < cells; cell++)
+		SetBit(solver.cells, cell);
+
+	Board board = rootBoard;
+	int moves[MAX_CELLS];
+	int count = GenerateMoves(board, moves);
+	if (count == 0 || GetResult(board) != RESULT_NONE)
+		return result;
+	for (int i = 0; i < count; i++) {
+		if (IsWinningMove(board, moves[i], board.sideToMove)) {
+			result.value = 1;
+			result.bestMove = moves[i];
+			return result;
+		}
+	}
+
+	//    ,    .    - 
+	const EndgameEntry& entry = solver.table[board.hash & solver.tableMask];
+	if (entry.key == board.hash && entry.move >= 0) {
+		for (int i = 1; i < count; i++) {
+			if (moves[i] == entry.move)
+				std::swap(moves[0], moves[i]);
+		}
+	}
+
+	int alpha = -1;
+	int best = -2;
+	for (int i = 0; i < count && best < 1; i++) {
+		MakeMove(board, moves[i]);
+		int value = -SolveNode(solver, board, -1, -alpha);
+		UndoMove(board);
+		if (solver.aborted)
+			break;
+		if (value > best) {
+			best = value;
+			result.bestMove = moves[i];
+			if (value > alpha)
+				alpha = value;
+		}
+	}
+
+	result.solved = !solver.aborted;
+	result.value = best;
+	result.nodes = solver.nodes;
+	return result;
+}
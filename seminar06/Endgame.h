@@ -0,0 +1,44 @@
+#pragma once
+#include <functional>
+#include <vector>
+#include "Board.h"
+
+//  : -      // (1/0/-1).
+//  ,      .    
+// ,      ,   -    (  )
+const int ENDGAME_TABLE_ENTRIES = 1 << 16;
+const uint64_t ENDGAME_STOP_CHECK_INTERVAL = 4096; //    ,  
+
+//true -  :     
+typedef std::function<bool()> EndgameStopCallback;
+
+struct EndgameEntry {
+	uint64_t key;
+	int16_t move;
+	int8_t value;
+	uint8_t bound;
+};
+
+struct EndgameSolver {
+	std::vector<EndgameEntry> table;
+	uint64_t tableMask;
+
+	//   
+	Bitboard cells; //  
+	uint64_t nodes;
+	uint64_t nodeLimit;
+	const EndgameStopCallback* shouldStop;
+	bool aborted;
+};
+
+struct EndgameResult {
+	bool solved; //false -   ,   
+	int value; //1 -  , 0 - , -1 - 
+	int bestMove; //-1,   
+	uint64_t nodes;
+};
+
+void InitEndgameSolver(EndgameSolver& solver);
+//nodeLimit 0 -  .    :  -  
+EndgameResult SolveEndgame(EndgameSolver& solver, const Board& board, uint64_t nodeLimit,
+	const EndgameStopCallback& shouldStop = EndgameStopCallback());
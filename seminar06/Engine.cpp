@@ -0,0 +1,542 @@
+#include <algorithm>
+#include <cstdlib>
+#include "Engine.h"
+#include "Metrics.h"
+#include "Threats.h"
+
+const uint8_t BOUND_EXACT = 0;
+const uint8_t BOUND_LOWER = 1; //   
+const uint8_t BOUND_UPPER = 2; //   
+const int INFINITE_SCORE = WIN_SCORE + 1;
+//    timeCheckInterval .         ,   ,
+//   ,      TIME_CHECK_MICROSECONDS
+const uint64_t TIME_CHECK_INTERVAL = 1024;
+const uint64_t TIME_CHECK_MIN_INTERVAL = 64;
+const uint64_t TIME_CHECK_MAX_INTERVAL = 65536;
+const int TIME_CHECK_MICROSECONDS = 200;
+const int MAX_DEPTH = INT8_MAX; //   TTEntry::depth
+const int THREAT_DEPTH = 12; //    
+const uint64_t THREAT_NODES = 5000; //     ,    
+const int ASPIRATION_WINDOW = 50; //       
+
+//      
+struct RootLine {
+	int move;
+	int score;
+};
+
+void InitEngine(Engine& engine, int tableMegabytes) {
+	size_t bytes = (size_t)tableMegabytes << 20;
+	size_t entries = 1;
+	while (entries * 2 * sizeof(TTEntry) <= bytes)
+		entries *= 2;
+
+	engine.table.assign(entries, TTEntry());
+	engine.tableMask = entries - 1;
+	engine.candidateRadius = 2;
+	engine.threatSearch = true;
+	engine.patternEval = true;
+	engine.network = NULL;
+	engine.accumulator.network = NULL;
+	engine.book = NULL;
+	engine.solveEmpties = DEFAULT_SOLVE_EMPTIES;
+	InitEndgameSolver(engine.endgame);
+	engine.patterns.lines = NULL;
+	engine.patterns.size = 0;
+	engine.patterns.winLength = 0;
+	engine.stop = false;
+	engine.ponder = false;
+	engine.nodes = 0;
+	engine.ttProbes = 0;
+	engine.ttHits = 0;
+	engine.nodeLimit = 0;
+	engine.hasDeadline = false;
+	engine.timeCheckInterval = TIME_CHECK_INTERVAL;
+	engine.nextTimeCheck = 0;
+}
+
+// ,      (,   )
+void ClearEngine(Engine& engine) {
+	std::fill(engine.table.begin(), engine.table.end(), TTEntry());
+	std::fill(engine.endgame.table.begin(), engine.endgame.table.end(), EndgameEntry());
+}
+
+//    ,   ,        
+static int ScoreToTable(int score, int ply) {
+	if (score >= WIN_SCORE - MAX_PLY)
+		return score + ply;
+	if (score <= -WIN_SCORE + MAX_PLY)
+		return score - ply;
+	return score;
+}
+
+static int ScoreFromTable(int score, int ply) {
+	if (score >= WIN_SCORE - MAX_PLY)
+		return score - ply;
+	if (score <= -WIN_SCORE + MAX_PLY)
+		return score + ply;
+	return score;
+}
+
+//     ,   ,  
+static int Evaluate(const Engine& engine, const Board& board) {
+	if (engine.accumulator.network)
+		return NetworkScore(engine.accumulator, board.sideToMove);
+	return engine.patterns.lines ? PatternScore(engine.patterns, board.sideToMove) : 0;
+}
+
+//  :           
+static void PlayMove(Engine& engine, Board& board, int cell) {
+	if (engine.accumulator.network)
+		AccumulatorMove(engine.accumulator, cell, board.sideToMove);
+	else if (engine.patterns.lines)
+		PatternMove(engine.patterns, cell, board.sideToMove);
+	MakeMove(board, cell);
+}
+
+static void TakeBack(Engine& engine, Board& board) {
+	UndoMove(board);
+	int cell = board.moves[board.moveCount];
+	if (engine.accumulator.network)
+		AccumulatorUndo(engine.accumulator, cell, board.sideToMove);
+	else if (engine.patterns.lines)
+		PatternUndo(engine.patterns, cell, board.sideToMove);
+}
+
+//   4x4      candidateRadius  
+static int GenerateCandidates(const Engine& engine, const Board& board, int* moves) {
+	if (board.size <= 4 || engine.candidateRadius <= 0)
+		return GenerateMoves(board, moves);
+	return GenerateNearbyMoves(board, engine.candidateRadius, moves);
+}
+
+//   ,     
+static void OrderMoves(const Board& board, int* moves, int count, int firstMove) {
+	int doubledCenter = board.size - 1;
+	auto distance = [&](int cell) {
+		return abs(2 * (cell % board.size) - doubledCenter) + abs(2 * (cell / board.size) - doubledCenter);
+	};
+	std::sort(moves, moves + count, [&](int a, int b) {
+		if (a == firstMove || b == firstMove)
+			return a == firstMove && b != firstMove;
+		return distance(a) < distance(b);
+	});
+}
+
+static bool ShouldStop(Engine& engine) {
+	if (engine.nodeLimit && engine.nodes >= engine.nodeLimit)
+		engine.stop = true;
+	else if (engine.hasDeadline && engine.nodes >= engine.nextTimeCheck && !engine.ponder.load(std::memory_order_relaxed)) {
+		auto now = std::chrono::steady_clock::now();
+		if (now >= engine.deadline)
+			engine.stop = true;
+
+		auto passed = now - engine.lastTimeCheck;
+		if (passed < std::chrono::microseconds(TIME_CHECK_MICROSECONDS / 2) && engine.timeCheckInterval < TIME_CHECK_MAX_INTERVAL)
+			engine.timeCheckInterval *= 2;
+		else if (passed > std::chrono::microseconds(TIME_CHECK_MICROSECONDS) && engine.timeCheckInterval > TIME_CHECK_MIN_INTERVAL)
+			engine.timeCheckInterval /= 2;
+		engine.lastTimeCheck = now;
+		engine.nextTimeCheck = engine.nodes + engine.timeCheckInterval;
+	}
+	return engine.stop;
+}
+
+//   (,  )        ,
+//       . nodes -   , 0 - 
+static uint64_t PhaseNodeLimit(const Engine& engine, uint64_t nodes) {
+	if (!engine.nodeLimit)
+		return nodes;
+	uint64_t left = engine.nodeLimit > engine.nodes ? engine.nodeLimit - engine.nodes : 0;
+	uint64_t half = std::max<uint64_t>(left / 2, 1);
+	return nodes ? std::min(nodes, half) : half;
+}
+
+// : stop       .   ,   ,
+//         
+static std::function<bool()> PhaseStop(Engine& engine) {
+	auto now = std::chrono::steady_clock::now();
+	auto deadline = now + (engine.deadline - now) / 2;
+	Engine* owner = &engine;
+	return [owner, deadline]() {
+		if (owner->stop.load(std::memory_order_relaxed))
+			return true;
+		return owner->hasDeadline && !owner->ponder.load(std::memory_order_relaxed) && std::chrono::steady_clock::now() >= deadline;
+	};
+}
+
+//    ,     :   
+static int StaticMoveScore(Engine& engine, Board& board, int move) {
+	if (IsWinningMove(board, move, board.sideToMove))
+		return WIN_SCORE - 1;
+	PlayMove(engine, board, move);
+	int score = board.moveCount == board.size * board.size ? 0 : -Evaluate(engine, board);
+	TakeBack(engine, board);
+	return score;
+}
+
+static int Negamax(Engine& engine, Board& board, int depth, int ply, int alpha, int beta) {
+	engine.nodes++;
+	if (ShouldStop(engine))
+		return 0;
+
+	//    ,        
+	if (board.moveCount == board.size * board.size)
+		return 0;
+	if (depth <= 0)
+		return Evaluate(engine, board);
+
+	TTEntry& entry = engine.table[board.hash & engine.tableMask];
+	int ttMove = -1;
+	engine.ttProbes++;
+	if (entry.key == board.hash) {
+		engine.ttHits++;
+		ttMove = entry.move;
+		if (entry.depth >= depth) {
+			int score = ScoreFromTable(entry.score, ply);
+			if (entry.bound == BOUND_EXACT ||
+				(entry.bound == BOUND_LOWER && score >= beta) ||
+				(entry.bound == BOUND_UPPER && score <= alpha))
+				return score;
+		}
+	}
+
+	int moves[MAX_CELLS];
+	int count = GenerateCandidates(engine, board, moves);
+
+	for (int i = 0; i < count; i++) {
+		if (IsWinningMove(board, moves[i], board.sideToMove))
+			return WIN_SCORE - ply - 1;
+	}
+
+	OrderMoves(board, moves, count, ttMove);
+
+	int originalAlpha = alpha;
+	int best = -INFINITE_SCORE;
+	int bestMove = moves[0];
+	for (int i = 0; i < count; i++) {
+		PlayMove(engine, board, moves[i]);
+		int score = -Negamax(engine, board, depth - 1, ply + 1, -beta, -alpha);
+		TakeBack(engine, board);
+
+		if (engine.stop)
+			return 0;
+
+		if (score > best) {
+			best = score;
+			bestMove = moves[i];
+			if (score > alpha) {
+				alpha = score;
+				if (alpha >= beta)
+					break;
+			}
+		}
+	}
+
+	entry.key = board.hash;
+	entry.score = (int16_t)ScoreToTable(best, ply);
+	entry.move = (int16_t)bestMove;
+	entry.depth = (int8_t)depth;
+	entry.bound = best <= originalAlpha ? BOUND_UPPER : (best >= beta ? BOUND_LOWER : BOUND_EXACT);
+	return best;
+}
+
+//  ,        .
+//excluded - ,    .    , bestMove = -1
+static int SearchRoot(Engine& engine, Board& board, int depth, int& bestMove, const std::vector<int>& excluded, int alpha, int beta) {
+	int moves[MAX_CELLS];
+	int count = GenerateCandidates(engine, board, moves);
+	if (!excluded.empty()) {
+		count = (int)(std::remove_if(moves, moves + count, [&](int move) {
+			return std::find(excluded.begin(), excluded.end(), move) != excluded.end();
+		}) - moves);
+	}
+	if (count == 0) {
+		bestMove = -1;
+		return -INFINITE_SCORE;
+	}
+
+	for (int i = 0; i < count; i++) {
+		if (IsWinningMove(board, moves[i], board.sideToMove)) {
+			bestMove = moves[i];
+			return WIN_SCORE - 1;
+		}
+	}
+
+	OrderMoves(board, moves, count, bestMove);
+
+	int best = -INFINITE_SCORE;
+	int move = moves[0];
+	for (int i = 0; i < count; i++) {
+		PlayMove(engine, board, moves[i]);
+		int score = -Negamax(engine, board, depth - 1, 1, -beta, -alpha);
+		TakeBack(engine, board);
+
+		if (engine.stop)
+			break;
+
+		if (score > best) {
+			best = score;
+			move = moves[i];
+			alpha = std::max(alpha, score);
+			if (alpha >= beta)
+				break;
+		}
+	}
+
+	bestMove = move;
+	return best;
+}
+
+//  :       .  , 
+//,    ,   .       
+//,       :      .
+//lines -   ,   - .    lines ,
+// bestMove     -    SearchRoot
+static int SearchMultiPv(Engine& engine, Board& board, int depth, int multiPv, std::vector<RootLine>& lines, int& bestMove) {
+	int best = -INFINITE_SCORE;
+	std::vector<RootLine> previous;
+	previous.swap(lines);
+	std::vector<int> excluded;
+	for (int index = 0; index < multiPv; index++) {
+		int move = index < (int)previous.size() ? previous[index].move : -1;
+		int delta = ASPIRATION_WINDOW;
+		int alpha = -INFINITE_SCORE, beta = INFINITE_SCORE;
+		if (index < (int)previous.size() && !IsWinScore(previous[index].score)) {
+			alpha = previous[index].score - delta;
+			beta = previous[index].score + delta;
+		}
+		if (!lines.empty())
+			beta = std::min(beta, lines.back().score + 1);
+		if (alpha >= beta)
+			alpha = -INFINITE_SCORE;
+
+		//    -  :        
+		int score;
+		for (;;) {
+			score = SearchRoot(engine, board, depth, move, excluded, alpha, beta);
+			if (engine.stop || move < 0)
+				break;
+			if (score <= alpha && alpha > -INFINITE_SCORE)
+				alpha = IsWinScore(score) ? -INFINITE_SCORE : std::max(score - delta, -INFINITE_SCORE);
+			else if (score >= beta && beta < INFINITE_SCORE)
+				beta = IsWinScore(score) ? INFINITE_SCORE : std::min(score + delta, INFINITE_SCORE);
+			else
+				break;
+			delta *= 4;
+		}
+
+		if (index == 0) {
+			bestMove = move;
+			best = score;
+		}
+		if (engine.stop || move < 0)
+			break;
+		lines.push_back({ move, score });
+		excluded.push_back(move);
+	}
+
+	//        ,  
+	std::stable_sort(lines.begin(), lines.end(), [](const RootLine& a, const RootLine& b) {
+		return a.score > b.score;
+	});
+	if (!engine.stop && !lines.empty()) {
+		bestMove = lines[0].move;
+		best = lines[0].score;
+	}
+	return best;
+}
+
+//     
+static std::vector<int> ExtractPv(const Engine& engine, Board board, int firstMove, int depth) {
+	std::vector<int> pv;
+	int move = firstMove;
+	while (move >= 0 && (int)pv.size() < depth && IsEmptyCell(board, move)) {
+		pv.push_back(move);
+		bool won = IsWinningMove(board, move, board.sideToMove);
+		MakeMove(board, move);
+		if (won || board.moveCount == board.size * board.size)
+			break;
+
+		const TTEntry& entry = engine.table[board.hash & engine.tableMask];
+		move = entry.key == board.hash ? entry.move : -1;
+	}
+	return pv;
+}
+
+SearchResult Search(Engine& engine, const Board& rootBoard, const SearchLimits& limits, const SearchInfoCallback& onInfo) {
+	auto start = std::chrono::steady_clock::now();
+	engine.nodes = 0;
+	engine.ttProbes = 0;
+	engine.ttHits = 0;
+	engine.nodeLimit = limits.nodes;
+	engine.hasDeadline = limits.timeMs > 0;
+	engine.deadline = start + std::chrono::milliseconds(limits.timeMs);
+	engine.lastTimeCheck = start;
+	engine.nextTimeCheck = engine.timeCheckInterval; //   :    
+
+	SearchResult result = { -1, 0, 0, 0, 0.0, -1 };
+	Board board = rootBoard;
+	int empty = board.size * board.size - board.moveCount;
+	if (empty == 0 || GetResult(board) != RESULT_NONE)
+		return result;
+
+	//      :    ,     .
+	//       ,      
+	int multiPv = std::max(limits.multiPv, 1);
+	if (engine.book && multiPv == 1) {
+		int move = ProbeBook(*engine.book, board);
+		if (move >= 0) {
+			result.bestMove = move;
+			result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+			CountMetric(METRIC_BOOK_HITS);
+			if (onInfo) {
+				SearchInfo info;
+				info.depth = 0;
+				info.line = 1;
+				info.score = 0;
+				info.nodes = 0;
+				info.timeMs = (int)(result.seconds * 1000);
+				info.pv.push_back(move);
+				onInfo(info);
+			}
+			return result;
+		}
+	}
+
+	//        ,     .
+	//       
+	if (engine.threatSearch && board.size > 4 && multiPv == 1) {
+		ThreatSearchResult threat = FindThreatWin(board, THREAT_DEPTH, PhaseNodeLimit(engine, THREAT_NODES), true, PhaseStop(engine));
+		engine.nodes += threat.nodes;
+		if (threat.win) {
+			result.bestMove = threat.move;
+			result.score = WIN_SCORE - threat.plies;
+			result.depth = threat.plies;
+			result.nodes = engine.nodes;
+			result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+			CountMetric(METRIC_ENGINE_NODES, engine.nodes);
+			if (onInfo) {
+				SearchInfo info;
+				info.depth = threat.plies;
+				info.line = 1;
+				info.score = result.score;
+				info.nodes = engine.nodes;
+				info.timeMs = (int)(result.seconds * 1000);
+				info.pv.push_back(threat.move);
+				onInfo(info);
+			}
+			return result;
+		}
+	}
+
+	//   :  .       ,  
+	//      .  -  ,   - 
+	//   .      -   ,   
+	if (engine.solveEmpties > 0 && empty <= engine.solveEmpties && (limits.depth <= 0 || limits.depth >= empty) && multiPv == 1) {
+		EndgameResult solved = SolveEndgame(engine.endgame, board, PhaseNodeLimit(engine, 0), PhaseStop(engine));
+		engine.nodes += solved.nodes;
+		if (solved.solved && solved.bestMove >= 0) {
+			result.bestMove = solved.bestMove;
+			result.score = solved.value * (WIN_SCORE - empty);
+			result.depth = empty;
+			result.nodes = engine.nodes;
+			result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+			CountMetric(METRIC_ENGINE_NODES, engine.nodes);
+			CountMetric(METRIC_ENDGAME_SOLVES);
+			if (onInfo) {
+				SearchInfo info;
+				info.depth = empty;
+				info.line = 1;
+				info.score = result.score;
+				info.nodes = engine.nodes;
+				info.timeMs = (int)(result.seconds * 1000);
+				info.pv.push_back(solved.bestMove);
+				onInfo(info);
+			}
+			return result;
+		}
+	}
+
+	//   :     ,       
+	engine.accumulator.network = NULL;
+	if (engine.network && engine.network->gridSize == board.size && engine.network->winLength == board.winLength)
+		InitAccumulator(engine.accumulator, *engine.network, board);
+	else if (engine.patternEval)
+		InitPatterns(engine.patterns, board);
+	else
+		engine.patterns.lines = NULL;
+
+	int maxDepth = std::min(limits.depth > 0 ? std::min(limits.depth, empty) : empty, MAX_DEPTH);
+	int bestMove = -1;
+	std::vector<int> noExcluded;
+	std::vector<RootLine> lines;
+	auto report = [&](int depth, int line, int move, int score) {
+		SearchInfo info;
+		info.depth = depth;
+		info.line = line;
+		info.score = score;
+		info.nodes = engine.nodes;
+		info.timeMs = (int)std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+		info.pv = ExtractPv(engine, board, move, depth);
+		onInfo(info);
+	};
+	for (int depth = 1; depth <= maxDepth; depth++) {
+		int score = multiPv > 1 ? SearchMultiPv(engine, board, depth, multiPv, lines, bestMove) :
+			SearchRoot(engine, board, depth, bestMove, noExcluded, -INFINITE_SCORE, INFINITE_SCORE);
+
+		//    ,   
+		if (engine.stop && result.bestMove >= 0)
+			break;
+
+		//    :   -  -INFINITE_SCORE    .  
+		//          ,   .
+		//    SearchRoot   ,     
+		if (engine.stop && score != WIN_SCORE - 1) {
+			result.bestMove = bestMove;
+			result.score = bestMove >= 0 ? StaticMoveScore(engine, board, bestMove) : 0;
+			break;
+		}
+
+		result.bestMove = bestMove;
+		result.score = score;
+		result.depth = depth;
+		if (engine.stop)
+			break;
+
+		if (onInfo && multiPv > 1) {
+			for (int i = 0; i < (int)lines.size(); i++)
+				report(depth, i + 1, lines[i].move, lines[i].score);
+		}
+		else if (onInfo)
+			report(depth, 1, bestMove, score);
+
+		//    (   -  ),   
+		if (multiPv > 1 ? std::all_of(lines.begin(), lines.end(), [](const RootLine& line) { return IsWinScore(line.score); }) : IsWinScore(score))
+			break;
+
+		//      ,      .
+		//     ,    
+		if (limits.softTimeMs > 0 && !engine.ponder.load(std::memory_order_relaxed) &&
+			std::chrono::steady_clock::now() - start >= std::chrono::milliseconds(limits.softTimeMs))
+			break;
+	}
+
+	//       ,     
+	CountMetric(METRIC_ENGINE_NODES, engine.nodes);
+	CountMetric(METRIC_TT_PROBES, engine.ttProbes);
+	CountMetric(METRIC_TT_HITS, engine.ttHits);
+
+	//    :      ,   
+	if (result.bestMove >= 0) {
+		std::vector<int> pv = ExtractPv(engine, board, result.bestMove, 2);
+		if (pv.size() >= 2)
+			result.ponderMove = pv[1];
+	}
+
+	//   ,    : stop,   ,   
+	engine.stop = false;
+	result.nodes = engine.nodes;
+	result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	return result;
+}
@@ -0,0 +1,91 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <vector>
+#include "Board.h"
+#include "Endgame.h"
+#include "Network.h"
+#include "OpeningBook.h"
+#include "Patterns.h"
+
+const int WIN_SCORE = 30000; //  n    WIN_SCORE - n
+const int MAX_PLY = MAX_CELLS;
+const int DEFAULT_SOLVE_EMPTIES = 16; //. Engine::solveEmpties
+
+//      
+inline bool IsWinScore(int score) {
+	return score >= WIN_SCORE - MAX_PLY || score <= -WIN_SCORE + MAX_PLY;
+}
+
+//  
+struct TTEntry {
+	uint64_t key;
+	int16_t score;
+	int16_t move;
+	int8_t depth;
+	uint8_t bound;
+};
+
+// ,  -  
+struct SearchLimits {
+	int depth;
+	uint64_t nodes;
+	int timeMs; //Ƹ :     
+	int softTimeMs; //       (. TimeManager.h)
+	int multiPv; //       , 0  1 -  
+};
+
+//    .  multiPv > 1   
+//    ,   
+struct SearchInfo {
+	int depth;
+	int line; // ,  1
+	int score;
+	uint64_t nodes;
+	int timeMs;
+	std::vector<int> pv; // 
+};
+
+struct SearchResult {
+	int bestMove; //-1,   
+	int score;
+	int depth;
+	uint64_t nodes;
+	double seconds;
+	int ponderMove; //   (   ), -1 - 
+};
+
+typedef std::function<void(const SearchInfo&)> SearchInfoCallback;
+
+//: -      
+struct Engine {
+	std::vector<TTEntry> table;
+	uint64_t tableMask;
+	int candidateRadius; //        , 0 - 
+	bool threatSearch; //      (. Threats.h)
+	bool patternEval; //    (. Patterns.h),   
+	const Network* network; //  (. Network.h)  , NULL -  . ,     k
+	const OpeningBook* book; // , NULL -  .        
+	int solveEmpties; //          (. Endgame.h), 0 - 
+	std::atomic<bool> stop; //    ,   .    
+	std::atomic<bool> ponder; //   :  ,   ,     
+
+	//   
+	EndgameSolver endgame;
+	PatternEval patterns;
+	NetworkAccumulator accumulator;
+	uint64_t nodes;
+	uint64_t ttProbes;
+	uint64_t ttHits;
+	uint64_t nodeLimit;
+	bool hasDeadline;
+	std::chrono::steady_clock::time_point deadline;
+	uint64_t timeCheckInterval; //   ,    
+	uint64_t nextTimeCheck;
+	std::chrono::steady_clock::time_point lastTimeCheck;
+};
+
+void InitEngine(Engine& engine, int tableMegabytes);
+void ClearEngine(Engine& engine);
+SearchResult Search(Engine& engine, const Board& board, const SearchLimits& limits, const SearchInfoCallback& onInfo);
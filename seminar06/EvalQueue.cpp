@@ -0,0 +1,256 @@
+#include <vector>
+#include "EvalQueue.h"
+#include "Metrics.h"
+#include "Patterns.h"
+
+// :         ,
+//    ,   .      
+static bool TryPush(EvalQueue& queue, EvalTicket* ticket) {
+	uint64_t position = queue.enqueuePosition.load(std::memory_order_relaxed);
+	for (;;) {
+		EvalQueueSlot& slot = queue.slots[position & queue.mask];
+		uint64_t sequence = slot.sequence.load(std::memory_order_acquire);
+		if (sequence == position) {
+			if (queue.enqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+				slot.ticket = ticket;
+				slot.sequence.store(position + 1, std::memory_order_release);
+				return true;
+			}
+		}
+		else if (sequence < position)
+			return false; // 
+		else
+			position = queue.enqueuePosition.load(std::memory_order_relaxed);
+	}
+}
+
+static EvalTicket* TryPop(EvalQueue& queue) {
+	uint64_t position = queue.dequeuePosition.load(std::memory_order_relaxed);
+	for (;;) {
+		EvalQueueSlot& slot = queue.slots[position & queue.mask];
+		uint64_t sequence = slot.sequence.load(std::memory_order_acquire);
+		if (sequence == position + 1) {
+			if (queue.dequeuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+				EvalTicket* ticket = slot.ticket;
+				slot.sequence.store(position + queue.mask + 1, std::memory_order_release);
+				return ticket;
+			}
+		}
+		else if (sequence < position + 1)
+			return NULL; // 
+		else
+			position = queue.dequeuePosition.load(std::memory_order_relaxed);
+	}
+}
+
+//    :      
+static void EvaluateBatch(EvalQueue& queue, std::vector<EvalTicket*>& batch) {
+	auto now = std::chrono::steady_clock::now();
+	uint64_t waited = 0;
+	for (EvalTicket* ticket : batch)
+		waited += std::chrono::duration_cast<std::chrono::microseconds>(now - ticket->queued).count();
+
+	queue.evaluate(batch.data(), (int)batch.size());
+	for (EvalTicket* ticket : batch)
+		ticket->done.store(true, std::memory_order_release);
+
+	queue.batches.fetch_add(1, std::memory_order_relaxed);
+	queue.leaves.fetch_add(batch.size(), std::memory_order_relaxed);
+	queue.queueMicroseconds.fetch_add(waited, std::memory_order_relaxed);
+	CountMetric(METRIC_EVAL_BATCHES);
+	CountMetric(METRIC_EVAL_LEAVES, batch.size());
+	CountMetric(METRIC_EVAL_QUEUE_MICROSECONDS, waited);
+	batch.clear();
+}
+
+static void EvalWorker(EvalQueue* queue) {
+	std::vector<EvalTicket*> batch;
+	batch.reserve(queue->batchSize);
+	int idle = 0;
+	while (!queue->stop.load(std::memory_order_acquire)) {
+		EvalTicket* ticket = TryPop(*queue);
+		if (ticket) {
+			batch.push_back(ticket);
+			idle = 0;
+		}
+
+		bool flush = false;
+		if (!batch.empty()) {
+			auto waited = std::chrono::steady_clock::now() - batch.front()->queued;
+			flush = (int)batch.size() >= queue->batchSize ||
+				(int)batch.size() >= queue->producers.load(std::memory_order_relaxed) ||
+				waited >= std::chrono::microseconds(queue->maxLatencyUs);
+		}
+		if (flush)
+			EvaluateBatch(*queue, batch);
+		else if (!ticket && ++idle >= EVAL_QUEUE_SPIN) {
+			std::this_thread::yield();
+			idle = 0;
+		}
+	}
+	//  ,     ,     
+	EvalTicket* ticket;
+	while ((ticket = TryPop(*queue)) != NULL) {
+		batch.push_back(ticket);
+		if ((int)batch.size() >= queue->batchSize)
+			EvaluateBatch(*queue, batch);
+	}
+	if (!batch.empty())
+		EvaluateBatch(*queue, batch);
+	queue->stopped.store(true, std::memory_order_release);
+}
+
+void StartEvalQueue(EvalQueue& queue, int capacity, int batchSize, int maxLatencyUs, const EvalBatchFunction& evaluate) {
+	uint64_t size = 1;
+	while (size < (uint64_t)capacity)
+		size *= 2;
+	queue.slots.reset(new EvalQueueSlot[size]);
+	for (uint64_t i = 0; i < size; i++)
+		queue.slots[i].sequence.store(i, std::memory_order_relaxed);
+	queue.mask = size - 1;
+	queue.enqueuePosition = 0;
+	queue.dequeuePosition = 0;
+	queue.producers = 0;
+	queue.batchSize = batchSize > 0 ? batchSize : 1;
+	queue.maxLatencyUs = maxLatencyUs;
+	queue.evaluate = evaluate;
+	queue.stop = false;
+	queue.stopped = false;
+	queue.batches = 0;
+	queue.leaves = 0;
+	queue.queueMicroseconds = 0;
+	queue.worker = std::thread(EvalWorker, &queue);
+}
+
+void StopEvalQueue(EvalQueue& queue) {
+	queue.stop = true;
+	if (queue.worker.joinable())
+		queue.worker.join();
+}
+
+void AddEvalProducers(EvalQueue& queue, int count) {
+	queue.producers.fetch_add(count, std::memory_order_relaxed);
+}
+
+int EvaluateQueued(EvalQueue& queue, EvalTicket& ticket) {
+	ticket.done.store(false, std::memory_order_relaxed);
+	ticket.queued = std::chrono::steady_clock::now();
+	while (!TryPush(queue, &ticket)) {
+		if (queue.stopped.load(std::memory_order_acquire))
+			return ticket.score = 0;
+		std::this_thread::yield();
+	}
+	//     ,  stopped,  done   
+	while (!ticket.done.load(std::memory_order_acquire)) {
+		if (queue.stopped.load(std::memory_order_acquire) && !ticket.done.load(std::memory_order_acquire))
+			return ticket.score = 0;
+		std::this_thread::yield();
+	}
+	return ticket.score;
+}
+
+EvalQueueStats ReadEvalQueueStats(const EvalQueue& queue) {
+	EvalQueueStats stats;
+	stats.batches = queue.batches.load();
+	stats.leaves = queue.leaves.load();
+	stats.averageFill = stats.batches ? (double)stats.leaves / stats.batches / queue.batchSize : 0.0;
+	stats.averageDelayUs = stats.leaves ? (double)queue.queueMicroseconds.load() / stats.leaves : 0.0;
+	return stats;
+}
+
+//,      .      
+struct BatchPosition {
+	Bitboard stones[2];
+	int size;
+	int winLength;
+	bool valid;
+};
+
+//   board:  ,   ,   .
+//        ,    
+template <typename Place, typename Remove>
+static void MoveToPosition(BatchPosition& last, const Board& board, Place place, Remove remove) {
+	int words = (board.size * board.size + 63) / 64;
+	for (int side = 0; side < 2; side++) {
+		for (int w = 0; w < words; w++) {
+			for (uint64_t bits = last.stones[side].words[w] & ~board.stones[side].words[w]; bits; bits &= bits - 1)
+				remove(w * 64 + LowestBit(bits), side);
+		}
+	}
+	for (int side = 0; side < 2; side++) {
+		for (int w = 0; w < words; w++) {
+			for (uint64_t bits = board.stones[side].words[w] & ~last.stones[side].words[w]; bits; bits &= bits - 1)
+				place(w * 64 + LowestBit(bits), side);
+		}
+	}
+	last.stones[SIDE_X] = board.stones[SIDE_X];
+	last.stones[SIDE_O] = board.stones[SIDE_O];
+}
+
+//  (   )  ,  - 
+struct NetworkBatchState {
+	NetworkAccumulator accumulator;
+	BatchPosition last;
+};
+
+EvalBatchFunction NetworkBatchEvaluator(const Network& network) {
+	const Network* shared = &network;
+	std::shared_ptr<NetworkBatchState> state = std::make_shared<NetworkBatchState>();
+	state->last.valid = false;
+	return [shared, state](EvalTicket* const* tickets, int count) {
+		NetworkAccumulator& accumulator = state->accumulator;
+		for (int i = 0; i < count; i++) {
+			const Board& board = tickets[i]->board;
+			if (board.size != shared->gridSize || board.winLength != shared->winLength) {
+				tickets[i]->score = 0;
+				continue;
+			}
+			if (!state->last.valid) {
+				InitAccumulator(accumulator, *shared, board);
+				state->last.stones[SIDE_X] = board.stones[SIDE_X];
+				state->last.stones[SIDE_O] = board.stones[SIDE_O];
+				state->last.valid = true;
+			}
+			else {
+				MoveToPosition(state->last, board,
+					[&](int cell, int side) { AccumulatorMove(accumulator, cell, side); },
+					[&](int cell, int side) { AccumulatorUndo(accumulator, cell, side); });
+			}
+			tickets[i]->score = NetworkScore(accumulator, board.sideToMove);
+		}
+	};
+}
+
+struct PatternBatchState {
+	PatternEval eval;
+	BatchPosition last;
+};
+
+EvalBatchFunction PatternBatchEvaluator() {
+	std::shared_ptr<PatternBatchState> state = std::make_shared<PatternBatchState>();
+	state->eval.lines = NULL;
+	state->eval.size = 0;
+	state->eval.winLength = 0;
+	state->last.valid = false;
+	return [state](EvalTicket* const* tickets, int count) {
+		PatternEval& eval = state->eval;
+		BatchPosition& last = state->last;
+		for (int i = 0; i < count; i++) {
+			const Board& board = tickets[i]->board;
+			if (!last.valid || last.size != board.size || last.winLength != board.winLength || !eval.lines) {
+				InitPatterns(eval, board);
+				last.stones[SIDE_X] = board.stones[SIDE_X];
+				last.stones[SIDE_O] = board.stones[SIDE_O];
+				last.size = board.size;
+				last.winLength = board.winLength;
+				last.valid = true;
+			}
+			else {
+				MoveToPosition(last, board,
+					[&](int cell, int side) { PatternMove(eval, cell, side); },
+					[&](int cell, int side) { PatternUndo(eval, cell, side); });
+			}
+			tickets[i]->score = PatternScore(eval, board.sideToMove);
+		}
+	};
+}
@@ -0,0 +1,72 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <thread>
+#include "Board.h"
+#include "Network.h"
+
+//   .         
+//  ,      batchSize     .
+//  ,      maxLatencyUs     
+const int EVAL_QUEUE_SPIN = 64; //      
+
+//   ,    ,     
+struct EvalTicket {
+	Board board;
+	int score; //   ,   
+	std::chrono::steady_clock::time_point queued;
+	std::atomic<bool> done;
+};
+
+// :   score   
+typedef std::function<void(EvalTicket* const* tickets, int count)> EvalBatchFunction;
+
+// :  ,   -  ( == )   ( + 1)
+struct EvalQueueSlot {
+	std::atomic<uint64_t> sequence;
+	EvalTicket* ticket;
+};
+
+struct EvalQueue {
+	std::unique_ptr<EvalQueueSlot[]> slots;
+	uint64_t mask;
+	alignas(64) std::atomic<uint64_t> enqueuePosition;
+	alignas(64) std::atomic<uint64_t> dequeuePosition;
+	alignas(64) std::atomic<int> producers; //     
+	int batchSize;
+	int maxLatencyUs;
+	EvalBatchFunction evaluate;
+	std::atomic<bool> stop;
+	std::atomic<bool> stopped; //     ,    
+	std::thread worker;
+
+	// ,    
+	std::atomic<uint64_t> batches;
+	std::atomic<uint64_t> leaves;
+	std::atomic<uint64_t> queueMicroseconds; //       
+};
+
+struct EvalQueueStats {
+	uint64_t batches;
+	uint64_t leaves;
+	double averageFill; // batchSize,  0  1
+	double averageDelayUs;
+};
+
+//capacity            
+void StartEvalQueue(EvalQueue& queue, int capacity, int batchSize, int maxLatencyUs, const EvalBatchFunction& evaluate);
+//,    ,     
+void StopEvalQueue(EvalQueue& queue);
+void AddEvalProducers(EvalQueue& queue, int count);
+//    .  ticket.score. ,    ,
+// : score = 0
+int EvaluateQueued(EvalQueue& queue, EvalTicket& ticket);
+EvalQueueStats ReadEvalQueueStats(const EvalQueue& queue);
+
+//  :  (   k )   .   ,
+//  ,          :
+//     ,      
+EvalBatchFunction NetworkBatchEvaluator(const Network& network);
+EvalBatchFunction PatternBatchEvaluator();
@@ -0,0 +1,309 @@
+#include <cstring>
+#include "GameLog.h"
+
+// : ,      ,  5   varint
+const int MAX_RECORD_SIZE = 5 * (5 + MAX_CELLS);
+
+static uint8_t* PutVarint(uint8_t* pos, uint32_t value) {
+	while (value >= 0x80) {
+		*pos++ = (uint8_t)(value | 0x80);
+		value >>= 7;
+	}
+	*pos++ = (uint8_t)value;
+	return pos;
+}
+
+static bool GetVarint(const uint8_t*& pos, const uint8_t* end, uint32_t& value) {
+	value = 0;
+	for (int shift = 0; shift < 35 && pos < end; shift += 7) {
+		uint8_t byte = *pos++;
+		value |= (uint32_t)(byte & 0x7F) << shift;
+		if (!(byte & 0x80))
+			return true;
+	}
+	return false;
+}
+
+static bool WriteBytes(HANDLE hFile, const void* data, size_t size) {
+	DWORD written = 0;
+	return WriteFile(hFile, data, (DWORD)size, &written, NULL) && written == size;
+}
+
+//   :  ,    
+static bool ParseRecord(const uint8_t* data, uint64_t size, uint64_t offset, GameRecord& record, uint64_t* nextOffset) {
+	if (offset < GAMELOG_HEADER_SIZE || offset >= size)
+		return false;
+
+	const uint8_t* pos = data + offset;
+	const uint8_t* end = data + size;
+	uint32_t length;
+	if (!GetVarint(pos, end, length) || length > (uint64_t)(end - pos))
+		return false;
+	end = pos + length;
+
+	uint32_t gridSize, winLength, result, moveCount;
+	if (!GetVarint(pos, end, gridSize) || !GetVarint(pos, end, winLength) ||
+		!GetVarint(pos, end, result) || !GetVarint(pos, end, moveCount))
+		return false;
+
+	if (gridSize == 0 || gridSize > MAX_GRID_SIZE || winLength == 0 || winLength > gridSize ||
+		result > RESULT_DRAW || moveCount > gridSize * gridSize)
+		return false;
+
+	record.gridSize = gridSize;
+	record.winLength = winLength;
+	record.result = result;
+	record.moveCount = moveCount;
+	record.moves = pos;
+	record.end = end;
+
+	if (nextOffset)
+		*nextOffset = end - data;
+	return true;
+}
+
+//     offset.      .
+//    
+static uint64_t ScanGameLog(const uint8_t* data, uint64_t size, uint64_t offset, std::vector<uint64_t>& offsets) {
+	offsets.clear();
+	GameRecord record;
+	uint64_t next;
+	while (offset < size && ParseRecord(data, size, offset, record, &next)) {
+		offsets.push_back(offset);
+		offset = next;
+	}
+	return offset;
+}
+
+//  ,        .
+//     tail. ,     
+static size_t ValidateIndex(const uint8_t* data, uint64_t size, const uint64_t* offsets, size_t count,
+	std::vector<uint64_t>& tail, uint64_t& logEnd) {
+	uint64_t start = GAMELOG_HEADER_SIZE;
+	GameRecord record;
+	uint64_t next;
+	if (count > 0 && ParseRecord(data, size, offsets[count - 1], record, &next))
+		start = next;
+	else
+		count = 0;
+
+	logEnd = ScanGameLog(data, size, start, tail);
+	return count;
+}
+
+static bool IsValidHeader(const uint8_t* data, uint64_t size) {
+	if (size < GAMELOG_HEADER_SIZE)
+		return false;
+	uint32_t header[2];
+	memcpy(header, data, sizeof(header));
+	return header[0] == GAMELOG_MAGIC && header[1] == GAMELOG_VERSION;
+}
+
+//   .       
+bool OpenGameLogWriter(const std::string& path, GameLogWriter& writer) {
+	writer.hLog = INVALID_HANDLE_VALUE;
+	writer.hIndex = INVALID_HANDLE_VALUE;
+	writer.offset = 0;
+	writer.buffer.clear();
+	writer.indexBuffer.clear();
+	writer.failed = false;
+
+	HANDLE hLog = CreateFileA(path.c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ, NULL, OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, NULL);
+	if (hLog == INVALID_HANDLE_VALUE)
+		return false;
+
+	LARGE_INTEGER logSize;
+	if (!GetFileSizeEx(hLog, &logSize)) {
+		CloseHandle(hLog);
+		return false;
+	}
+
+	std::string indexPath = path + ".idx";
+	std::vector<uint64_t> tail;
+	size_t indexCount = 0, indexSize = 0;
+	uint64_t logEnd = GAMELOG_HEADER_SIZE;
+
+	if (logSize.QuadPart == 0) {
+		uint32_t header[2] = { GAMELOG_MAGIC, GAMELOG_VERSION };
+		if (!WriteBytes(hLog, header, sizeof(header))) {
+			CloseHandle(hLog);
+			return false;
+		}
+	}
+	else {
+		MappedFile log, index;
+		if (!OpenMappedFile(path, log) || !IsValidHeader(log.data, log.size)) {
+			CloseMappedFile(log);
+			CloseHandle(hLog);
+			return false;
+		}
+
+		if (OpenMappedFile(indexPath, index)) {
+			indexSize = (size_t)index.size;
+			indexCount = ValidateIndex(log.data, log.size, (const uint64_t*)index.data, indexSize / sizeof(uint64_t), tail, logEnd);
+		}
+		else
+			indexCount = ValidateIndex(log.data, log.size, NULL, 0, tail, logEnd);
+
+		CloseMappedFile(index);
+		CloseMappedFile(log);
+	}
+
+	//    ,      .
+	//     : SetEndOfFile  ,    
+	LARGE_INTEGER position;
+	position.QuadPart = (LONGLONG)logEnd;
+	if (!SetFilePointerEx(hLog, position, NULL, FILE_BEGIN) || (logEnd < (uint64_t)logSize.QuadPart && !SetEndOfFile(hLog))) {
+		CloseHandle(hLog);
+		return false;
+	}
+
+	HANDLE hIndex = CreateFileA(indexPath.c_str(), GENERIC_WRITE, FILE_SHARE_READ, NULL, OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, NULL);
+	if (hIndex == INVALID_HANDLE_VALUE) {
+		CloseHandle(hLog);
+		return false;
+	}
+
+	//          
+	position.QuadPart = (LONGLONG)(indexCount * sizeof(uint64_t));
+	if (!SetFilePointerEx(hIndex, position, NULL, FILE_BEGIN) || (indexCount * sizeof(uint64_t) < indexSize && !SetEndOfFile(hIndex)) ||
+		(!tail.empty() && !WriteBytes(hIndex, tail.data(), tail.size() * sizeof(uint64_t)))) {
+		CloseHandle(hIndex);
+		CloseHandle(hLog);
+		return false;
+	}
+
+	writer.hLog = hLog;
+	writer.hIndex = hIndex;
+	writer.offset = logEnd;
+	writer.buffer.reserve(GAMELOG_BUFFER_SIZE + MAX_RECORD_SIZE);
+	return true;
+}
+
+//   .          FlushGameLog
+void WriteGame(GameLogWriter& writer, const Board& board, int result) {
+	if (writer.failed)
+		return;
+
+	uint8_t body[MAX_RECORD_SIZE];
+	uint8_t* pos = PutVarint(body, board.size);
+	pos = PutVarint(pos, board.winLength);
+	pos = PutVarint(pos, result);
+	pos = PutVarint(pos, board.moveCount);
+	for (int i = 0; i < board.moveCount; i++)
+		pos = PutVarint(pos, board.moves[i]);
+
+	uint8_t length[5];
+	uint8_t* lengthEnd = PutVarint(length, (uint32_t)(pos - body));
+
+	writer.buffer.insert(writer.buffer.end(), length, lengthEnd);
+	writer.buffer.insert(writer.buffer.end(), body, pos);
+	writer.indexBuffer.push_back(writer.offset);
+	writer.offset += (lengthEnd - length) + (pos - body);
+
+	if (writer.buffer.size() >= GAMELOG_BUFFER_SIZE)
+		FlushGameLog(writer);
+}
+
+// ,  :       .
+//     :     failed
+bool FlushGameLog(GameLogWriter& writer) {
+	if (writer.hLog == INVALID_HANDLE_VALUE || writer.failed)
+		return false;
+
+	bool ok = true;
+	if (!writer.buffer.empty())
+		ok = WriteBytes(writer.hLog, writer.buffer.data(), writer.buffer.size());
+	if (ok && !writer.indexBuffer.empty())
+		ok = WriteBytes(writer.hIndex, writer.indexBuffer.data(), writer.indexBuffer.size() * sizeof(uint64_t));
+	writer.buffer.clear();
+	writer.indexBuffer.clear();
+	writer.failed = !ok;
+	return ok;
+}
+
+void CloseGameLogWriter(GameLogWriter& writer) {
+	FlushGameLog(writer);
+	if (writer.hIndex != INVALID_HANDLE_VALUE) {
+		CloseHandle(writer.hIndex);
+		writer.hIndex = INVALID_HANDLE_VALUE;
+	}
+	if (writer.hLog != INVALID_HANDLE_VALUE) {
+		CloseHandle(writer.hLog);
+		writer.hLog = INVALID_HANDLE_VALUE;
+	}
+}
+
+bool OpenGameLogReader(const std::string& path, GameLogReader& reader) {
+	reader.offsets = NULL;
+	reader.indexedCount = 0;
+	reader.tail.clear();
+	reader.count = 0;
+	reader.index.data = NULL;
+	reader.index.hMapping = NULL;
+	reader.index.hFile = INVALID_HANDLE_VALUE;
+
+	if (!OpenMappedFile(path, reader.log))
+		return false;
+
+	if (!IsValidHeader(reader.log.data, reader.log.size)) {
+		CloseMappedFile(reader.log);
+		return false;
+	}
+
+	uint64_t logEnd;
+	if (OpenMappedFile(path + ".idx", reader.index)) {
+		reader.offsets = (const uint64_t*)reader.index.data;
+		reader.indexedCount = ValidateIndex(reader.log.data, reader.log.size, reader.offsets,
+			(size_t)(reader.index.size / sizeof(uint64_t)), reader.tail, logEnd);
+	}
+	else {
+		ValidateIndex(reader.log.data, reader.log.size, NULL, 0, reader.tail, logEnd);
+	}
+
+	reader.count = reader.indexedCount + reader.tail.size();
+	return true;
+}
+
+void CloseGameLogReader(GameLogReader& reader) {
+	CloseMappedFile(reader.index);
+	CloseMappedFile(reader.log);
+	reader.tail.clear();
+	reader.offsets = NULL;
+	reader.indexedCount = 0;
+	reader.count = 0;
+}
+
+//   : nextOffset    
+bool ReadGameAt(const GameLogReader& reader, uint64_t offset, GameRecord& record, uint64_t* nextOffset) {
+	return ParseRecord(reader.log.data, reader.log.size, offset, record, nextOffset);
+}
+
+//      
+bool GetGame(const GameLogReader& reader, size_t number, GameRecord& record) {
+	if (number >= reader.count)
+		return false;
+
+	uint64_t offset = number < reader.indexedCount ? reader.offsets[number] : reader.tail[number - reader.indexedCount];
+	return ParseRecord(reader.log.data, reader.log.size, offset, record, NULL);
+}
+
+bool NextMove(GameRecord& record, int& cell) {
+	uint32_t value;
+	if (record.moves >= record.end || !GetVarint(record.moves, record.end, value) || value >= (uint32_t)(record.gridSize * record.gridSize))
+		return false;
+	cell = value;
+	return true;
+}
+
+//       
+bool ReplayGame(GameRecord record, Board& board) {
+	InitBoard(board, record.gridSize, record.winLength);
+	for (int i = 0; i < record.moveCount; i++) {
+		int cell;
+		if (!NextMove(record, cell) || !IsEmptyCell(board, cell) || GetResult(board) != RESULT_NONE)
+			return false;
+		MakeMove(board, cell);
+	}
+	return true;
+}
@@ -0,0 +1,57 @@
+#pragma once
+#include <Windows.h>
+#include <string>
+#include <vector>
+#include "Board.h"
+#include "MappedFile.h"
+
+// : ,   ,   .
+//: varint gridSize, winLength, result, moveCount,    (varint).
+//   <>.idx:     uint64.
+const uint32_t GAMELOG_MAGIC = 0x47545454; //"TTTG"
+const uint32_t GAMELOG_VERSION = 1;
+const uint64_t GAMELOG_HEADER_SIZE = 8;
+const size_t GAMELOG_BUFFER_SIZE = 1 << 16; //     
+
+//     
+struct GameLogWriter {
+	HANDLE hLog;
+	HANDLE hIndex;
+	uint64_t offset; //    
+	std::vector<uint8_t> buffer;
+	std::vector<uint64_t> indexBuffer;
+	bool failed; //    : offset     ,    .
+	             //     ,     
+};
+
+bool OpenGameLogWriter(const std::string& path, GameLogWriter& writer);
+void WriteGame(GameLogWriter& writer, const Board& board, int result);
+bool FlushGameLog(GameLogWriter& writer);
+void CloseGameLogWriter(GameLogWriter& writer);
+
+//,   .       
+struct GameLogReader {
+	MappedFile log;
+	MappedFile index;
+	const uint64_t* offsets; //   
+	size_t indexedCount; //     
+	std::vector<uint64_t> tail; //,     (      )
+	size_t count;
+};
+
+//   .       NextMove
+struct GameRecord {
+	int gridSize;
+	int winLength;
+	int result;
+	int moveCount;
+	const uint8_t* moves;
+	const uint8_t* end;
+};
+
+bool OpenGameLogReader(const std::string& path, GameLogReader& reader);
+void CloseGameLogReader(GameLogReader& reader);
+bool ReadGameAt(const GameLogReader& reader, uint64_t offset, GameRecord& record, uint64_t* nextOffset);
+bool GetGame(const GameLogReader& reader, size_t number, GameRecord& record);
+bool NextMove(GameRecord& record, int& cell);
+bool ReplayGame(GameRecord record, Board& board);
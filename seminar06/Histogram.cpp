@@ -0,0 +1,101 @@
+#include <cstdio>
+#include <cstring>
+#include "Histogram.h"
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+//   , x    
+static int HighestBit(uint64_t x) {
+#if defined(_MSC_VER) && defined(_WIN64)
+	unsigned long index;
+	_BitScanReverse64(&index, x);
+	return (int)index;
+#elif defined(_MSC_VER)
+	unsigned long index;
+	if (_BitScanReverse(&index, (unsigned long)(x >> 32)))
+		return (int)index + 32;
+	_BitScanReverse(&index, (unsigned long)x);
+	return (int)index;
+#else
+	return 63 - __builtin_clzll(x);
+#endif
+}
+
+//  HISTOGRAM_SUB_BUCKETS  ,  -   2^shift
+static int BucketIndex(uint64_t value) {
+	if (value < HISTOGRAM_SUB_BUCKETS)
+		return (int)value;
+	int shift = HighestBit(value) - HISTOGRAM_SUB_BITS;
+	return (shift + 1) * HISTOGRAM_SUB_BUCKETS + (int)(value >> shift) - HISTOGRAM_SUB_BUCKETS;
+}
+
+// ,   
+static uint64_t BucketValue(int index) {
+	if (index < HISTOGRAM_SUB_BUCKETS)
+		return index;
+	int shift = index / HISTOGRAM_SUB_BUCKETS - 1;
+	uint64_t sub = index % HISTOGRAM_SUB_BUCKETS + HISTOGRAM_SUB_BUCKETS;
+	return ((sub + 1) << shift) - 1;
+}
+
+void ClearHistogram(Histogram& histogram) {
+	memset(histogram.counts, 0, sizeof(histogram.counts));
+	histogram.total = 0;
+	histogram.min = UINT64_MAX;
+	histogram.max = 0;
+}
+
+void RecordValue(Histogram& histogram, uint64_t value) {
+	histogram.counts[BucketIndex(value)]++;
+	histogram.total++;
+	if (value < histogram.min)
+		histogram.min = value;
+	if (value > histogram.max)
+		histogram.max = value;
+}
+
+void MergeHistogram(Histogram& to, const Histogram& from) {
+	for (int i = 0; i < HISTOGRAM_BUCKETS; i++)
+		to.counts[i] += from.counts[i];
+	to.total += from.total;
+	if (from.min < to.min)
+		to.min = from.min;
+	if (from.max > to.max)
+		to.max = from.max;
+}
+
+//,    percentile   (0..100)
+uint64_t ValueAtPercentile(const Histogram& histogram, double percentile) {
+	if (histogram.total == 0)
+		return 0;
+
+	uint64_t rank = (uint64_t)(percentile / 100.0 * histogram.total + 0.5);
+	if (rank < 1)
+		rank = 1;
+	uint64_t seen = 0;
+	for (int i = 0; i < HISTOGRAM_BUCKETS; i++) {
+		seen += histogram.counts[i];
+		if (seen >= rank)
+			return BucketValue(i) < histogram.max ? BucketValue(i) : histogram.max;
+	}
+	return histogram.max;
+}
+
+// :  , min, p50, p99, p999  max   
+std::string FormatHistogram(const Histogram& histogram, const char* name, double unitsPerValue, const char* unit) {
+	char line[256];
+	if (histogram.total == 0) {
+		snprintf(line, sizeof(line), "%-20s count 0", name);
+		return line;
+	}
+
+	snprintf(line, sizeof(line), "%-20s count %llu  min %.1f  p50 %.1f  p99 %.1f  p999 %.1f  max %.1f %s", name,
+		(unsigned long long)histogram.total,
+		histogram.min * unitsPerValue,
+		ValueAtPercentile(histogram, 50.0) * unitsPerValue,
+		ValueAtPercentile(histogram, 99.0) * unitsPerValue,
+		ValueAtPercentile(histogram, 99.9) * unitsPerValue,
+		histogram.max * unitsPerValue, unit);
+	return line;
+}
@@ -0,0 +1,23 @@
+#pragma once
+#include <cstdint>
+#include <string>
+
+//    HdrHistogram:    ,  
+// HISTOGRAM_SUB_BUCKETS  .      1/HISTOGRAM_SUB_BUCKETS,
+// -     
+const int HISTOGRAM_SUB_BITS = 5;
+const int HISTOGRAM_SUB_BUCKETS = 1 << HISTOGRAM_SUB_BITS;
+const int HISTOGRAM_BUCKETS = (64 - HISTOGRAM_SUB_BITS + 1) * HISTOGRAM_SUB_BUCKETS;
+
+struct Histogram {
+	uint64_t counts[HISTOGRAM_BUCKETS];
+	uint64_t total;
+	uint64_t min;
+	uint64_t max;
+};
+
+void ClearHistogram(Histogram& histogram);
+void RecordValue(Histogram& histogram, uint64_t value);
+void MergeHistogram(Histogram& to, const Histogram& from);
+uint64_t ValueAtPercentile(const Histogram& histogram, double percentile);
+std::string FormatHistogram(const Histogram& histogram, const char* name, double unitsPerValue, const char* unit);
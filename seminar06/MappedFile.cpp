@@ -0,0 +1,54 @@
+#include "MappedFile.h"
+
+bool OpenMappedFile(const std::string& path, MappedFile& file) {
+	file.hFile = INVALID_HANDLE_VALUE;
+	file.hMapping = NULL;
+	file.data = NULL;
+	file.size = 0;
+
+	//    ,    
+	HANDLE hFile = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+	if (hFile == INVALID_HANDLE_VALUE)
+		return false;
+
+	LARGE_INTEGER fileSize;
+	if (!GetFileSizeEx(hFile, &fileSize) || fileSize.QuadPart == 0) {
+		CloseHandle(hFile);
+		return false;
+	}
+
+	HANDLE hMapping = CreateFileMapping(hFile, NULL, PAGE_READONLY, 0, 0, NULL);
+	if (hMapping == NULL) {
+		CloseHandle(hFile);
+		return false;
+	}
+
+	const uint8_t* data = (const uint8_t*)MapViewOfFile(hMapping, FILE_MAP_READ, 0, 0, 0);
+	if (data == NULL) {
+		CloseHandle(hMapping);
+		CloseHandle(hFile);
+		return false;
+	}
+
+	file.hFile = hFile;
+	file.hMapping = hMapping;
+	file.data = data;
+	file.size = (uint64_t)fileSize.QuadPart;
+	return true;
+}
+
+void CloseMappedFile(MappedFile& file) {
+	if (file.data) {
+		UnmapViewOfFile(file.data);
+		file.data = NULL;
+	}
+	if (file.hMapping) {
+		CloseHandle(file.hMapping);
+		file.hMapping = NULL;
+	}
+	if (file.hFile != INVALID_HANDLE_VALUE) {
+		CloseHandle(file.hFile);
+		file.hFile = INVALID_HANDLE_VALUE;
+	}
+	file.size = 0;
+}
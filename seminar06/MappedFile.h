@@ -0,0 +1,15 @@
+#pragma once
+#include <Windows.h>
+#include <cstdint>
+#include <string>
+
+//,      
+struct MappedFile {
+	HANDLE hFile;
+	HANDLE hMapping;
+	const uint8_t* data;
+	uint64_t size;
+};
+
+bool OpenMappedFile(const std::string& path, MappedFile& file);
+void CloseMappedFile(MappedFile& file);
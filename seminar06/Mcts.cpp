@@ -0,0 +1,143 @@
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <memory>
+#include <thread>
+#include "Mcts.h"
+
+struct MctsTree {
+	std::vector<MctsNode> nodes; //nodes[0] - .   ,   -  
+	std::mutex mutex;
+	Board root;
+	MctsLimits limits;
+	std::atomic<uint64_t> started; // ,      
+};
+
+// :      ,      
+static void AddChildren(MctsTree& tree, const Board& board, int node) {
+	int moves[MAX_CELLS];
+	int count = board.size > 4 && tree.limits.candidateRadius > 0 ?
+		GenerateNearbyMoves(board, tree.limits.candidateRadius, moves) : GenerateMoves(board, moves);
+	int cells = board.size * board.size;
+
+	tree.nodes[node].firstChild = (int)tree.nodes.size();
+	tree.nodes[node].childCount = count;
+	for (int i = 0; i < count; i++) {
+		MctsNode child = { moves[i], -1, 0, 0, 0, 0.0, RESULT_NONE };
+		if (IsWinningMove(board, moves[i], board.sideToMove))
+			child.result = board.sideToMove == SIDE_X ? RESULT_X_WIN : RESULT_O_WIN;
+		else if (board.moveCount + 1 == cells)
+			child.result = RESULT_DRAW;
+		tree.nodes.push_back(child);
+	}
+}
+
+//UCT.      ,     
+static int SelectChild(const MctsTree& tree, int node) {
+	const MctsNode& parent = tree.nodes[node];
+	double logTotal = std::log((double)std::max(parent.visits + parent.virtualLoss, 1));
+	int best = parent.firstChild;
+	double bestScore = -1.0;
+	for (int i = parent.firstChild; i < parent.firstChild + parent.childCount; i++) {
+		const MctsNode& child = tree.nodes[i];
+		int visits = child.visits + child.virtualLoss;
+		if (visits == 0)
+			return i;
+		double score = child.value / visits + MCTS_EXPLORATION * std::sqrt(logTotal / visits);
+		if (score > bestScore) {
+			bestScore = score;
+			best = i;
+		}
+	}
+	return best;
+}
+
+static void RunPlayouts(MctsTree& tree, EvalQueue& queue) {
+	std::unique_ptr<EvalTicket> ticket(new EvalTicket());
+	std::vector<int> path;
+	Board board;
+	while (tree.started++ < tree.limits.playouts) {
+		//     
+		double value = 0.0; //  ,    
+		bool evaluate = false;
+		{
+			std::lock_guard<std::mutex> lock(tree.mutex);
+			board = tree.root;
+			path.clear();
+			path.push_back(0);
+			int node = 0;
+			while (tree.nodes[node].result == RESULT_NONE && tree.nodes[node].childCount > 0) {
+				node = SelectChild(tree, node);
+				tree.nodes[node].virtualLoss += MCTS_VIRTUAL_LOSS;
+				MakeMove(board, tree.nodes[node].move);
+				path.push_back(node);
+			}
+
+			const MctsNode& leaf = tree.nodes[node];
+			if (leaf.result != RESULT_NONE)
+				value = leaf.result == RESULT_DRAW ? 0.5 : 1.0; //    
+			else if (leaf.firstChild < 0) {
+				AddChildren(tree, board, node);
+				evaluate = true;
+			}
+		}
+
+		//   :        
+		if (evaluate) {
+			ticket->board = board;
+			int score = EvaluateQueued(queue, *ticket);
+			value = 1.0 - 1.0 / (1.0 + std::exp(-score / MCTS_SCORE_SCALE));
+		}
+
+		std::lock_guard<std::mutex> lock(tree.mutex);
+		for (int i = (int)path.size() - 1; i >= 0; i--) {
+			MctsNode& node = tree.nodes[path[i]];
+			if (i > 0)
+				node.virtualLoss -= MCTS_VIRTUAL_LOSS;
+			node.visits++;
+			node.value += value;
+			value = 1.0 - value;
+		}
+	}
+}
+
+MctsResult SearchMcts(const Board& board, const MctsLimits& limits, EvalQueue& queue) {
+	auto start = std::chrono::steady_clock::now();
+	MctsResult result = { -1, 0, 0, 0.0, {} };
+	if (GetResult(board) != RESULT_NONE)
+		return result;
+
+	MctsTree tree;
+	tree.root = board;
+	tree.limits = limits;
+	tree.started = 0;
+	tree.nodes.push_back({ -1, -1, 0, 0, 0, 0.0, RESULT_NONE });
+	AddChildren(tree, board, 0);
+
+	int threads = std::max(limits.threads, 1);
+	AddEvalProducers(queue, threads);
+	std::vector<std::thread> workers;
+	for (int i = 0; i < threads; i++) {
+		workers.emplace_back([&tree, &queue]() {
+			RunPlayouts(tree, queue);
+			AddEvalProducers(queue, -1); //  -    
+		});
+	}
+	for (std::thread& worker : workers)
+		worker.join();
+
+	const MctsNode& root = tree.nodes[0];
+	for (int i = root.firstChild; i < root.firstChild + root.childCount; i++) {
+		const MctsNode& child = tree.nodes[i];
+		result.moves.push_back({ child.move, child.visits, child.visits ? child.value / child.visits : 0.0 });
+	}
+	std::stable_sort(result.moves.begin(), result.moves.end(), [](const MctsMoveStats& a, const MctsMoveStats& b) {
+		return a.visits > b.visits;
+	});
+	if (!result.moves.empty())
+		result.bestMove = result.moves[0].move;
+	result.playouts = root.visits;
+	result.nodes = tree.nodes.size();
+	result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	return result;
+}
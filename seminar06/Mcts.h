@@ -0,0 +1,44 @@
+#pragma once
+#include <mutex>
+#include <vector>
+#include "Board.h"
+#include "EvalQueue.h"
+
+//     - (UCT).     
+//       ,     .
+//     EvalQueue,     
+const double MCTS_EXPLORATION = 1.4;
+const int MCTS_VIRTUAL_LOSS = 1;
+const double MCTS_SCORE_SCALE = 600.0; //   : 1 / (1 + exp(-score / scale))
+
+struct MctsNode {
+	int move;
+	int firstChild; //  , -1 -   
+	int childCount;
+	int visits;
+	int virtualLoss;
+	double value; //   ,  move:  1,  0.5
+	int result; //   move  RESULT_NONE
+};
+
+struct MctsLimits {
+	uint64_t playouts;
+	int threads;
+	int candidateRadius; //  Engine:        
+};
+
+struct MctsMoveStats {
+	int move;
+	int visits;
+	double value; //   
+};
+
+struct MctsResult {
+	int bestMove; //  , -1   
+	uint64_t playouts;
+	uint64_t nodes;
+	double seconds;
+	std::vector<MctsMoveStats> moves; //    
+};
+
+MctsResult SearchMcts(const Board& board, const MctsLimits& limits, EvalQueue& queue);
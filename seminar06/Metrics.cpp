@@ -0,0 +1,193 @@
+#include <winsock2.h>
+#include <atomic>
+#include <cstdio>
+#include "Metrics.h"
+
+#pragma comment(lib, "Ws2_32.lib")
+
+const int MAX_METRICS_THREADS = 256;
+const int METRICS_CLIENT_TIMEOUT_MS = 1000; //       
+
+struct MetricInfo {
+	const char* name;
+	const char* help;
+};
+
+static const MetricInfo metricInfo[METRIC_COUNT] = {
+	{ "ttt_moves_total", "Moves applied to games." },
+	{ "ttt_paints_total", "WM_PAINT messages handled." },
+	{ "ttt_notifications_total", "Board update notifications posted to other windows." },
+	{ "ttt_config_reloads_total", "Settings file loads." },
+	{ "ttt_engine_nodes_total", "Nodes searched by the engine." },
+	{ "ttt_tt_probes_total", "Transposition table probes." },
+	{ "ttt_tt_hits_total", "Transposition table probes that found the position." },
+	{ "ttt_book_hits_total", "Moves answered from the opening book without search." },
+	{ "ttt_eval_batches_total", "Leaf evaluation batches processed by the evaluation queue." },
+	{ "ttt_eval_leaves_total", "Leaves evaluated in those batches." },
+	{ "ttt_eval_queue_microseconds_total", "Total time leaves waited in the queue before evaluation." },
+	{ "ttt_ponders_total", "Background searches started on the opponent's time." },
+	{ "ttt_ponder_hits_total", "Background searches whose predicted reply was played." },
+	{ "ttt_endgame_solves_total", "Searches answered exactly by the endgame solver." },
+};
+
+//   .   ,   
+//  ,  atomic ,       
+struct alignas(64) MetricsBlock {
+	std::atomic<uint64_t> values[METRIC_COUNT];
+};
+
+//    :  alignas     new  C++17,
+//     .      
+static MetricsBlock metricsBlocks[MAX_METRICS_THREADS];
+static std::atomic<int> metricsBlockCount(0); //  MAX_METRICS_THREADS
+static MetricsBlock sharedBlock; //   MAX_METRICS_THREADS,    
+static thread_local MetricsBlock* threadMetrics = NULL;
+
+static MetricsBlock* GetThreadMetrics() {
+	if (threadMetrics)
+		return threadMetrics;
+
+	int slot = metricsBlockCount.load();
+	while (slot < MAX_METRICS_THREADS && !metricsBlockCount.compare_exchange_weak(slot, slot + 1)) {
+	}
+	threadMetrics = slot < MAX_METRICS_THREADS ? &metricsBlocks[slot] : &sharedBlock;
+	return threadMetrics;
+}
+
+void CountMetric(int metric, uint64_t amount) {
+	MetricsBlock* block = GetThreadMetrics();
+	if (block == &sharedBlock) {
+		sharedBlock.values[metric].fetch_add(amount, std::memory_order_relaxed);
+		return;
+	}
+	std::atomic<uint64_t>& value = block->values[metric];
+	value.store(value.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+}
+
+uint64_t ReadMetric(int metric) {
+	uint64_t total = sharedBlock.values[metric].load(std::memory_order_relaxed);
+	int blocks = metricsBlockCount.load();
+	for (int i = 0; i < blocks; i++)
+		total += metricsBlocks[i].values[metric].load(std::memory_order_relaxed);
+	return total;
+}
+
+std::string RenderMetrics() {
+	std::string text;
+	char line[256];
+	uint64_t values[METRIC_COUNT];
+	for (int i = 0; i < METRIC_COUNT; i++) {
+		values[i] = ReadMetric(i);
+		snprintf(line, sizeof(line), "# HELP %s %s\n# TYPE %s counter\n%s %llu\n",
+			metricInfo[i].name, metricInfo[i].help, metricInfo[i].name, metricInfo[i].name, (unsigned long long)values[i]);
+		text += line;
+	}
+
+	//      ;      rate()    
+	double hitRatio = values[METRIC_TT_PROBES] ? (double)values[METRIC_TT_HITS] / values[METRIC_TT_PROBES] : 0.0;
+	snprintf(line, sizeof(line), "# HELP ttt_tt_hit_ratio Transposition table hits per probe since start.\n# TYPE ttt_tt_hit_ratio gauge\nttt_tt_hit_ratio %.6f\n", hitRatio);
+	text += line;
+
+	double leavesPerBatch = values[METRIC_EVAL_BATCHES] ? (double)values[METRIC_EVAL_LEAVES] / values[METRIC_EVAL_BATCHES] : 0.0;
+	snprintf(line, sizeof(line), "# HELP ttt_eval_leaves_per_batch Average evaluation batch fill since start.\n# TYPE ttt_eval_leaves_per_batch gauge\nttt_eval_leaves_per_batch %.3f\n", leavesPerBatch);
+	text += line;
+
+	double ponderHitRatio = values[METRIC_PONDERS] ? (double)values[METRIC_PONDER_HITS] / values[METRIC_PONDERS] : 0.0;
+	snprintf(line, sizeof(line), "# HELP ttt_ponder_hit_ratio Ponder hits per ponder search since start.\n# TYPE ttt_ponder_hit_ratio gauge\nttt_ponder_hit_ratio %.6f\n", ponderHitRatio);
+	text += line;
+	return text;
+}
+
+//   :  ,   
+static void ServeMetricsRequest(SOCKET client) {
+	std::string request;
+	char buffer[1024];
+	while (request.find("\r\n\r\n") == std::string::npos && request.size() < 8192) {
+		int received = recv(client, buffer, sizeof(buffer), 0);
+		if (received <= 0)
+			return;
+		request.append(buffer, received);
+	}
+
+	std::string status = "200 OK", body;
+	if (request.compare(0, 13, "GET /metrics ") == 0)
+		body = RenderMetrics();
+	else {
+		status = "404 Not Found";
+		body = "not found\n";
+	}
+
+	std::string response = "HTTP/1.1 " + status + "\r\n"
+		"Content-Type: text/plain; version=0.0.4; charset=utf-8\r\n"
+		"Content-Length: " + std::to_string(body.size()) + "\r\n"
+		"Connection: close\r\n\r\n" + body;
+	size_t offset = 0;
+	while (offset < response.size()) {
+		int sent = send(client, response.data() + offset, (int)(response.size() - offset), 0);
+		if (sent <= 0)
+			return;
+		offset += sent;
+	}
+}
+
+//  (     Prometheus),       accept
+bool StartMetricsServer(MetricsServer& server, int port) {
+	WSADATA wsaData;
+	if (WSAStartup(MAKEWORD(2, 2), &wsaData) != 0)
+		return false;
+
+	SOCKET listener = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+	if (listener == INVALID_SOCKET) {
+		WSACleanup();
+		return false;
+	}
+
+	sockaddr_in address = { 0 };
+	address.sin_family = AF_INET;
+	address.sin_addr.s_addr = htonl(INADDR_LOOPBACK); //  
+	address.sin_port = htons((u_short)port);
+	if (bind(listener, (sockaddr*)&address, sizeof(address)) == SOCKET_ERROR || listen(listener, SOMAXCONN) == SOCKET_ERROR) {
+		closesocket(listener);
+		WSACleanup();
+		return false;
+	}
+
+	server.listener = (uintptr_t)listener;
+	server.client = 0;
+	MetricsServer* owner = &server;
+	server.thread = std::thread([listener, owner]() {
+		SOCKET client;
+		while ((client = accept(listener, NULL, NULL)) != INVALID_SOCKET) {
+			// ,    ,     recv
+			DWORD timeout = METRICS_CLIENT_TIMEOUT_MS;
+			setsockopt(client, SOL_SOCKET, SO_RCVTIMEO, (const char*)&timeout, sizeof(timeout));
+			setsockopt(client, SOL_SOCKET, SO_SNDTIMEO, (const char*)&timeout, sizeof(timeout));
+			{
+				std::lock_guard<std::mutex> lock(owner->mutex);
+				owner->client = (uintptr_t)client;
+			}
+			ServeMetricsRequest(client);
+			{
+				std::lock_guard<std::mutex> lock(owner->mutex);
+				owner->client = 0;
+			}
+			closesocket(client);
+		}
+	});
+	return true;
+}
+
+//   accept,    .   ,
+//    
+void StopMetricsServer(MetricsServer& server) {
+	if (!server.thread.joinable())
+		return;
+	closesocket((SOCKET)server.listener);
+	{
+		std::lock_guard<std::mutex> lock(server.mutex);
+		if (server.client)
+			shutdown((SOCKET)server.client, SD_BOTH);
+	}
+	server.thread.join();
+	WSACleanup();
+}
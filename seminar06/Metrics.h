@@ -0,0 +1,38 @@
+#pragma once
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+
+//.           ,
+//     
+const int METRIC_MOVES = 0; //    (  )
+const int METRIC_PAINTS = 1; // WM_PAINT
+const int METRIC_NOTIFICATIONS = 2; //   WM_UPDATE_BOARD
+const int METRIC_CONFIG_RELOADS = 3; // settings.json
+const int METRIC_ENGINE_NODES = 4; //  
+const int METRIC_TT_PROBES = 5; //   
+const int METRIC_TT_HITS = 6; //,  
+const int METRIC_BOOK_HITS = 7; //,      
+const int METRIC_EVAL_BATCHES = 8; // ,   (. EvalQueue.h)
+const int METRIC_EVAL_LEAVES = 9; //   
+const int METRIC_EVAL_QUEUE_MICROSECONDS = 10; //    
+const int METRIC_PONDERS = 11; //     (. AsyncEngine.h)
+const int METRIC_PONDER_HITS = 12; //,   
+const int METRIC_ENDGAME_SOLVES = 13; //,     (. Endgame.h)
+const int METRIC_COUNT = 14;
+
+void CountMetric(int metric, uint64_t amount = 1);
+uint64_t ReadMetric(int metric);
+std::string RenderMetrics(); //  Prometheus
+
+//HTTP-  127.0.0.1,  RenderMetrics()  GET /metrics
+struct MetricsServer {
+	uintptr_t listener; //SOCKET,    winsock  
+	std::mutex mutex;
+	uintptr_t client; // , 0 - .  mutex,      
+	std::thread thread;
+};
+
+bool StartMetricsServer(MetricsServer& server, int port);
+void StopMetricsServer(MetricsServer& server);
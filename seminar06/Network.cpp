@@ -0,0 +1,279 @@
+#include <algorithm>
+#include <cstdio>
+#include <random>
+#include "Network.h"
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define NETWORK_X86
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#endif
+
+//MSVC     , GCC  Clang -    
+#if defined(NETWORK_X86) && defined(__GNUC__)
+#define TARGET_AVX2 __attribute__((target("avx2")))
+#define TARGET_VNNI __attribute__((target("avx2,avx512vl,avx512vnni")))
+#else
+#define TARGET_AVX2
+#define TARGET_VNNI
+#endif
+
+int DetectNetworkKernel() {
+#if defined(NETWORK_X86) && defined(_MSC_VER)
+	int info[4];
+	__cpuid(info, 0);
+	if (info[0] < 7)
+		return NETWORK_KERNEL_SCALAR;
+	__cpuid(info, 1);
+	bool osSavesAvx = (info[2] & (1 << 27)) && (info[2] & (1 << 28)) && (_xgetbv(0) & 0x6) == 0x6;
+	if (!osSavesAvx)
+		return NETWORK_KERNEL_SCALAR;
+	__cpuidex(info, 7, 0);
+	bool avx2 = (info[1] & (1 << 5)) != 0;
+	bool vnni = (info[1] & (1 << 31)) && (info[2] & (1 << 11)) && (_xgetbv(0) & 0xE6) == 0xE6; //AVX512VL, AVX512_VNNI   zmm
+	return vnni && avx2 ? NETWORK_KERNEL_VNNI : (avx2 ? NETWORK_KERNEL_AVX2 : NETWORK_KERNEL_SCALAR);
+#elif defined(NETWORK_X86)
+	if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("avx512vl") && __builtin_cpu_supports("avx512vnni"))
+		return NETWORK_KERNEL_VNNI;
+	return __builtin_cpu_supports("avx2") ? NETWORK_KERNEL_AVX2 : NETWORK_KERNEL_SCALAR;
+#else
+	return NETWORK_KERNEL_SCALAR;
+#endif
+}
+
+const char* NetworkKernelName(int kernel) {
+	switch (kernel) {
+	case NETWORK_KERNEL_AVX2: return "avx2";
+	case NETWORK_KERNEL_VNNI: return "vnni";
+	default: return "scalar";
+	}
+}
+
+bool LoadNetwork(const std::string& path, Network& network) {
+	FILE* file;
+	if (fopen_s(&file, path.c_str(), "rb") != 0)
+		return false;
+
+	NetworkFileHeader header;
+	bool ok = fread(&header, sizeof(header), 1, file) == 1 &&
+		header.magic == NETWORK_MAGIC && header.version == NETWORK_VERSION &&
+		header.inputs == NETWORK_INPUTS && header.hidden == NETWORK_HIDDEN && header.layer2 == NETWORK_LAYER2 &&
+		header.gridSize >= 1 && header.gridSize <= MAX_GRID_SIZE && header.winLength >= 1 && header.winLength <= header.gridSize;
+	ok = ok &&
+		fread(network.featureBias, sizeof(network.featureBias), 1, file) == 1 &&
+		fread(network.featureWeights, sizeof(network.featureWeights), 1, file) == 1 &&
+		fread(network.layer2Bias, sizeof(network.layer2Bias), 1, file) == 1 &&
+		fread(network.layer2Weights, sizeof(network.layer2Weights), 1, file) == 1 &&
+		fread(network.outputWeights, sizeof(network.outputWeights), 1, file) == 1 &&
+		fread(&network.outputBias, sizeof(network.outputBias), 1, file) == 1;
+	fclose(file);
+
+	if (ok) {
+		network.gridSize = header.gridSize;
+		network.winLength = header.winLength;
+		network.kernel = DetectNetworkKernel();
+	}
+	return ok;
+}
+
+void InitRandomNetwork(Network& network, int gridSize, int winLength, unsigned seed) {
+	std::mt19937 rng(seed);
+	auto weight = [&](int limit) {
+		return (int)(rng() % (2 * limit + 1)) - limit;
+	};
+
+	network.gridSize = gridSize;
+	network.winLength = winLength;
+	network.kernel = DetectNetworkKernel();
+	//    ,        int16
+	for (int i = 0; i < NETWORK_HIDDEN; i++)
+		network.featureBias[i] = (int16_t)weight(32);
+	for (int input = 0; input < NETWORK_INPUTS; input++) {
+		for (int i = 0; i < NETWORK_HIDDEN; i++)
+			network.featureWeights[input][i] = (int8_t)weight(8);
+	}
+	for (int o = 0; o < NETWORK_LAYER2; o++) {
+		network.layer2Bias[o] = weight(1 << 12);
+		for (int i = 0; i < 2 * NETWORK_HIDDEN; i++)
+			network.layer2Weights[o][i] = (int8_t)weight(NETWORK_ACTIVATION_MAX);
+		network.outputWeights[o] = (int8_t)weight(NETWORK_ACTIVATION_MAX);
+	}
+	network.outputBias = 0;
+}
+
+//  side   cell    perspective:    
+static int FeatureIndex(int perspective, int cell, int side) {
+	return (side == perspective ? 0 : MAX_CELLS) + cell;
+}
+
+static void AddFeatureScalar(int16_t* values, const int8_t* weights) {
+	for (int i = 0; i < NETWORK_HIDDEN; i++)
+		values[i] = (int16_t)(values[i] + weights[i]);
+}
+
+static void SubFeatureScalar(int16_t* values, const int8_t* weights) {
+	for (int i = 0; i < NETWORK_HIDDEN; i++)
+		values[i] = (int16_t)(values[i] - weights[i]);
+}
+
+//  :   
+static void ClipAccumulatorScalar(const NetworkAccumulator& accumulator, int side, uint8_t* activations) {
+	for (int half = 0; half < 2; half++) {
+		const int16_t* values = accumulator.values[half == 0 ? side : side ^ 1];
+		for (int i = 0; i < NETWORK_HIDDEN; i++)
+			activations[half * NETWORK_HIDDEN + i] = (uint8_t)std::min(std::max((int)values[i], 0), NETWORK_ACTIVATION_MAX);
+	}
+}
+
+static void Layer2Scalar(const Network& network, const uint8_t* input, int32_t* sums) {
+	for (int o = 0; o < NETWORK_LAYER2; o++) {
+		int32_t sum = 0;
+		for (int i = 0; i < 2 * NETWORK_HIDDEN; i++)
+			sum += input[i] * network.layer2Weights[o][i];
+		sums[o] = sum;
+	}
+}
+
+#ifdef NETWORK_X86
+TARGET_AVX2 static void AddFeatureAvx2(int16_t* values, const int8_t* weights) {
+	for (int i = 0; i < NETWORK_HIDDEN; i += 16) {
+		__m256i value = _mm256_loadu_si256((const __m256i*)(values + i));
+		__m256i weight = _mm256_cvtepi8_epi16(_mm_loadu_si128((const __m128i*)(weights + i)));
+		_mm256_storeu_si256((__m256i*)(values + i), _mm256_add_epi16(value, weight));
+	}
+}
+
+TARGET_AVX2 static void SubFeatureAvx2(int16_t* values, const int8_t* weights) {
+	for (int i = 0; i < NETWORK_HIDDEN; i += 16) {
+		__m256i value = _mm256_loadu_si256((const __m256i*)(values + i));
+		__m256i weight = _mm256_cvtepi8_epi16(_mm_loadu_si128((const __m128i*)(weights + i)));
+		_mm256_storeu_si256((__m256i*)(values + i), _mm256_sub_epi16(value, weight));
+	}
+}
+
+//  [0, 127]   int16 -> uint8. packus  128- , permute  
+TARGET_AVX2 static void ClipAccumulatorAvx2(const NetworkAccumulator& accumulator, int side, uint8_t* activations) {
+	const __m256i zero = _mm256_setzero_si256();
+	const __m256i maximum = _mm256_set1_epi16(NETWORK_ACTIVATION_MAX);
+	for (int half = 0; half < 2; half++) {
+		const int16_t* values = accumulator.values[half == 0 ? side : side ^ 1];
+		for (int i = 0; i < NETWORK_HIDDEN; i += 32) {
+			__m256i low = _mm256_min_epi16(_mm256_max_epi16(_mm256_loadu_si256((const __m256i*)(values + i)), zero), maximum);
+			__m256i high = _mm256_min_epi16(_mm256_max_epi16(_mm256_loadu_si256((const __m256i*)(values + i + 16)), zero), maximum);
+			__m256i packed = _mm256_permute4x64_epi64(_mm256_packus_epi16(low, high), 0xD8);
+			_mm256_storeu_si256((__m256i*)(activations + half * NETWORK_HIDDEN + i), packed);
+		}
+	}
+}
+
+TARGET_AVX2 static int32_t HorizontalSum(__m256i sum) {
+	__m128i half = _mm_add_epi32(_mm256_castsi256_si128(sum), _mm256_extracti128_si256(sum, 1));
+	half = _mm_add_epi32(half, _mm_shuffle_epi32(half, 0x4E));
+	half = _mm_add_epi32(half, _mm_shuffle_epi32(half, 0xB1));
+	return _mm_cvtsi128_si32(half);
+}
+
+//maddubs  uint8  int8     int16:    127,
+//    2 * 127 * 128   . madd     int32
+TARGET_AVX2 static void Layer2Avx2(const Network& network, const uint8_t* input, int32_t* sums) {
+	const __m256i ones = _mm256_set1_epi16(1);
+	for (int o = 0; o < NETWORK_LAYER2; o++) {
+		__m256i sum = _mm256_setzero_si256();
+		for (int i = 0; i < 2 * NETWORK_HIDDEN; i += 32) {
+			__m256i activation = _mm256_loadu_si256((const __m256i*)(input + i));
+			__m256i weight = _mm256_loadu_si256((const __m256i*)(network.layer2Weights[o] + i));
+			__m256i products = _mm256_madd_epi16(_mm256_maddubs_epi16(activation, weight), ones);
+			sum = _mm256_add_epi32(sum, products);
+		}
+		sums[o] = HorizontalSum(sum);
+	}
+}
+
+//dpbusd           int32
+TARGET_VNNI static void Layer2Vnni(const Network& network, const uint8_t* input, int32_t* sums) {
+	for (int o = 0; o < NETWORK_LAYER2; o++) {
+		__m256i sum = _mm256_setzero_si256();
+		for (int i = 0; i < 2 * NETWORK_HIDDEN; i += 32) {
+			__m256i activation = _mm256_loadu_si256((const __m256i*)(input + i));
+			__m256i weight = _mm256_loadu_si256((const __m256i*)(network.layer2Weights[o] + i));
+			sum = _mm256_dpbusd_epi32(sum, activation, weight);
+		}
+		sums[o] = HorizontalSum(sum);
+	}
+}
+#endif
+
+static void AddFeature(const Network& network, int16_t* values, int feature) {
+#ifdef NETWORK_X86
+	if (network.kernel != NETWORK_KERNEL_SCALAR) {
+		AddFeatureAvx2(values, network.featureWeights[feature]);
+		return;
+	}
+#endif
+	AddFeatureScalar(values, network.featureWeights[feature]);
+}
+
+static void SubFeature(const Network& network, int16_t* values, int feature) {
+#ifdef NETWORK_X86
+	if (network.kernel != NETWORK_KERNEL_SCALAR) {
+		SubFeatureAvx2(values, network.featureWeights[feature]);
+		return;
+	}
+#endif
+	SubFeatureScalar(values, network.featureWeights[feature]);
+}
+
+void InitAccumulator(NetworkAccumulator& accumulator, const Network& network, const Board& board) {
+	accumulator.network = &network;
+	for (int perspective = 0; perspective < 2; perspective++)
+		std::copy(network.featureBias, network.featureBias + NETWORK_HIDDEN, accumulator.values[perspective]);
+	for (int cell = 0; cell < board.size * board.size; cell++) {
+		if (TestBit(board.stones[SIDE_X], cell))
+			AccumulatorMove(accumulator, cell, SIDE_X);
+		else if (TestBit(board.stones[SIDE_O], cell))
+			AccumulatorMove(accumulator, cell, SIDE_O);
+	}
+}
+
+void AccumulatorMove(NetworkAccumulator& accumulator, int cell, int side) {
+	for (int perspective = 0; perspective < 2; perspective++)
+		AddFeature(*accumulator.network, accumulator.values[perspective], FeatureIndex(perspective, cell, side));
+}
+
+void AccumulatorUndo(NetworkAccumulator& accumulator, int cell, int side) {
+	for (int perspective = 0; perspective < 2; perspective++)
+		SubFeature(*accumulator.network, accumulator.values[perspective], FeatureIndex(perspective, cell, side));
+}
+
+int NetworkScore(const NetworkAccumulator& accumulator, int side) {
+	const Network& network = *accumulator.network;
+	alignas(32) uint8_t activations[2 * NETWORK_HIDDEN];
+	int32_t sums[NETWORK_LAYER2];
+
+#ifdef NETWORK_X86
+	if (network.kernel != NETWORK_KERNEL_SCALAR) {
+		ClipAccumulatorAvx2(accumulator, side, activations);
+		if (network.kernel == NETWORK_KERNEL_VNNI)
+			Layer2Vnni(network, activations, sums);
+		else
+			Layer2Avx2(network, activations, sums);
+	}
+	else
+#endif
+	{
+		ClipAccumulatorScalar(accumulator, side, activations);
+		Layer2Scalar(network, activations, sums);
+	}
+
+	//   - 32 ,   
+	int32_t output = network.outputBias;
+	for (int o = 0; o < NETWORK_LAYER2; o++) {
+		int activation = std::min(std::max((sums[o] + network.layer2Bias[o]) >> NETWORK_LAYER2_SHIFT, 0), NETWORK_ACTIVATION_MAX);
+		output += activation * network.outputWeights[o];
+	}
+
+	int score = output / NETWORK_OUTPUT_DIVISOR;
+	return std::min(std::max(score, -NETWORK_SCORE_LIMIT), NETWORK_SCORE_LIMIT);
+}
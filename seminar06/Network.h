@@ -0,0 +1,69 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include "Board.h"
+
+//    NNUE.  - :    (X  O) 
+//"/   ",  2 * MAX_CELLS.      
+//()       .    
+//  int8    [0, 127]    
+const int NETWORK_INPUTS = 2 * MAX_CELLS;
+const int NETWORK_HIDDEN = 128; //  
+const int NETWORK_LAYER2 = 32;
+const int NETWORK_ACTIVATION_MAX = 127; //   uint8,     int8 
+const int NETWORK_LAYER2_SHIFT = 6; //     
+const int NETWORK_OUTPUT_DIVISOR = 16; //    
+const int NETWORK_SCORE_LIMIT = 10000; // PATTERN_SCORE_LIMIT:    
+
+const uint32_t NETWORK_MAGIC = 0x4E545454; //"TTTN"
+const uint32_t NETWORK_VERSION = 1;
+
+// .     ,    
+const int NETWORK_KERNEL_SCALAR = 0;
+const int NETWORK_KERNEL_AVX2 = 1;
+const int NETWORK_KERNEL_VNNI = 2; //AVX-512 VNNI  256- 
+
+//       k.      int16
+struct Network {
+	int gridSize;
+	int winLength;
+	int kernel;
+	alignas(32) int16_t featureBias[NETWORK_HIDDEN];
+	alignas(32) int8_t featureWeights[NETWORK_INPUTS][NETWORK_HIDDEN];
+	alignas(32) int32_t layer2Bias[NETWORK_LAYER2];
+	alignas(32) int8_t layer2Weights[NETWORK_LAYER2][2 * NETWORK_HIDDEN]; //:   
+	alignas(32) int8_t outputWeights[NETWORK_LAYER2];
+	int32_t outputBias;
+};
+
+// : NetworkFileHeader,      Network  featureBias  outputBias
+struct NetworkFileHeader {
+	uint32_t magic;
+	uint32_t version;
+	int32_t gridSize;
+	int32_t winLength;
+	int32_t inputs;
+	int32_t hidden;
+	int32_t layer2;
+	uint32_t reserved;
+};
+
+//     
+struct NetworkAccumulator {
+	const Network* network; //NULL,    
+	alignas(32) int16_t values[2][NETWORK_HIDDEN]; //values[]
+};
+
+int DetectNetworkKernel();
+const char* NetworkKernelName(int kernel);
+
+bool LoadNetwork(const std::string& path, Network& network);
+//  :  ,       
+void InitRandomNetwork(Network& network, int gridSize, int winLength, unsigned seed);
+
+void InitAccumulator(NetworkAccumulator& accumulator, const Network& network, const Board& board);
+void AccumulatorMove(NetworkAccumulator& accumulator, int cell, int side);
+void AccumulatorUndo(NetworkAccumulator& accumulator, int cell, int side);
+
+//   side,     NETWORK_SCORE_LIMIT
+int NetworkScore(const NetworkAccumulator& accumulator, int side);
@@ -0,0 +1,169 @@
+#include <algorithm>
+#include <unordered_map>
+#include "OpeningBook.h"
+#include "GameLog.h"
+
+bool OpenOpeningBook(const std::string& path, OpeningBook& book) {
+	book.header = NULL;
+	book.entries = NULL;
+	if (!OpenMappedFile(path, book.file))
+		return false;
+
+	const BookHeader* header = (const BookHeader*)book.file.data;
+	bool valid = book.file.size >= sizeof(BookHeader) &&
+		header->magic == BOOK_MAGIC && header->version == BOOK_VERSION && header->entrySize == sizeof(BookEntry) &&
+		header->gridSize >= 1 && header->gridSize <= MAX_GRID_SIZE && header->winLength >= 1 && header->winLength <= header->gridSize &&
+		header->entryCount == (book.file.size - sizeof(BookHeader)) / sizeof(BookEntry);
+	if (!valid) {
+		CloseMappedFile(book.file);
+		return false;
+	}
+
+	book.header = header;
+	book.entries = (const BookEntry*)(book.file.data + sizeof(BookHeader));
+	return true;
+}
+
+void CloseOpeningBook(OpeningBook& book) {
+	CloseMappedFile(book.file);
+	book.header = NULL;
+	book.entries = NULL;
+}
+
+int ProbeBook(const OpeningBook& book, const Board& board) {
+	const BookHeader& header = *book.header;
+	if (board.size != header.gridSize || board.winLength != header.winLength || board.moveCount >= header.maxPly)
+		return -1;
+
+	int symmetry;
+	uint64_t key = CanonicalKey(board, symmetry);
+	const BookEntry* end = book.entries + header.entryCount;
+	const BookEntry* entry = std::lower_bound(book.entries, end, key, [](const BookEntry& entry, uint64_t key) {
+		return entry.key < key;
+	});
+	if (entry == end || entry->key != key)
+		return -1;
+
+	//     ,    .   -  
+	int cell = InverseTransformCell(entry->move, board.size, symmetry);
+	return IsEmptyCell(board, cell) ? cell : -1;
+}
+
+//    .   :  2,  1
+struct BookMoveStats {
+	int move;
+	uint64_t games;
+	uint64_t points;
+};
+
+static bool IsBetterBookMove(const BookMoveStats& a, const BookMoveStats& b, int minGames) {
+	bool aTrusted = a.games >= (uint64_t)minGames, bTrusted = b.games >= (uint64_t)minGames;
+	if (aTrusted != bTrusted)
+		return aTrusted;
+	//     
+	if (aTrusted && a.points * b.games != b.points * a.games)
+		return a.points * b.games > b.points * a.games;
+	return a.games > b.games;
+}
+
+//     ,      
+static bool WriteBookFile(const std::string& path, const BookHeader& header, const std::vector<BookEntry>& entries) {
+	std::string tempPath = path + ".tmp";
+	HANDLE hFile = CreateFileA(tempPath.c_str(), GENERIC_WRITE, 0, NULL, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, NULL);
+	if (hFile == INVALID_HANDLE_VALUE)
+		return false;
+
+	DWORD written = 0;
+	DWORD entryBytes = (DWORD)(entries.size() * sizeof(BookEntry));
+	bool ok = WriteFile(hFile, &header, sizeof(header), &written, NULL) && written == sizeof(header);
+	if (ok && entryBytes > 0)
+		ok = WriteFile(hFile, entries.data(), entryBytes, &written, NULL) && written == entryBytes;
+	CloseHandle(hFile);
+
+	if (!ok) {
+		DeleteFileA(tempPath.c_str());
+		return false;
+	}
+	return MoveFileExA(tempPath.c_str(), path.c_str(), MOVEFILE_REPLACE_EXISTING) != 0;
+}
+
+bool BuildOpeningBook(const std::vector<std::string>& logPaths, const BookBuildOptions& options, const std::string& path, BookBuildStats& stats) {
+	stats.games = 0;
+	stats.positions = 0;
+	stats.entries = 0;
+
+	std::unordered_map<uint64_t, std::vector<BookMoveStats>> positions;
+	for (const std::string& logPath : logPaths) {
+		GameLogReader reader;
+		if (!OpenGameLogReader(logPath, reader))
+			return false;
+
+		for (size_t i = 0; i < reader.count; i++) {
+			GameRecord record;
+			Board game;
+			if (!GetGame(reader, i, record) || record.gridSize != options.gridSize || record.winLength != options.winLength ||
+				record.result == RESULT_NONE || !ReplayGame(record, game))
+				continue;
+			stats.games++;
+
+			Board board;
+			InitBoard(board, game.size, game.winLength);
+			int plies = std::min(game.moveCount, options.maxPly);
+			for (int ply = 0; ply < plies; ply++) {
+				int symmetry;
+				uint64_t key = CanonicalKey(board, symmetry);
+				int move = TransformCell(game.moves[ply], board.size, symmetry);
+				int winner = record.result == RESULT_X_WIN ? SIDE_X : (record.result == RESULT_O_WIN ? SIDE_O : -1);
+				uint64_t points = winner < 0 ? 1 : (winner == board.sideToMove ? 2 : 0);
+
+				std::vector<BookMoveStats>& moves = positions[key];
+				auto found = std::find_if(moves.begin(), moves.end(), [move](const BookMoveStats& stats) { return stats.move == move; });
+				if (found == moves.end())
+					moves.push_back({ move, 1, points });
+				else {
+					found->games++;
+					found->points += points;
+				}
+				MakeMove(board, game.moves[ply]);
+			}
+		}
+		CloseGameLogReader(reader);
+	}
+	stats.positions = positions.size();
+
+	std::vector<BookEntry> entries;
+	for (const auto& position : positions) {
+		const std::vector<BookMoveStats>& moves = position.second;
+		uint64_t games = 0;
+		for (const BookMoveStats& move : moves)
+			games += move.games;
+		if (games < (uint64_t)options.minGames)
+			continue;
+
+		const BookMoveStats* best = &moves[0];
+		for (const BookMoveStats& move : moves) {
+			if (IsBetterBookMove(move, *best, options.minGames))
+				best = &move;
+		}
+		BookEntry entry = {};
+		entry.key = position.first;
+		entry.move = (uint16_t)best->move;
+		entry.games = (uint16_t)std::min<uint64_t>(best->games, UINT16_MAX);
+		entry.score = (uint16_t)(best->points * 500 / best->games);
+		entries.push_back(entry);
+	}
+	std::sort(entries.begin(), entries.end(), [](const BookEntry& a, const BookEntry& b) {
+		return a.key < b.key;
+	});
+	stats.entries = entries.size();
+
+	BookHeader header = {};
+	header.magic = BOOK_MAGIC;
+	header.version = BOOK_VERSION;
+	header.gridSize = options.gridSize;
+	header.winLength = options.winLength;
+	header.maxPly = options.maxPly;
+	header.entrySize = sizeof(BookEntry);
+	header.entryCount = entries.size();
+	return WriteBookFile(path, header, entries);
+}
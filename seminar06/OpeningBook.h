@@ -0,0 +1,61 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "Board.h"
+#include "MappedFile.h"
+
+// :    "  -> ",   .
+//    (. CanonicalKey),      .
+//       :  -   
+const uint32_t BOOK_MAGIC = 0x42545454; //"TTTB"
+const uint32_t BOOK_VERSION = 1;
+
+struct BookHeader {
+	uint32_t magic;
+	uint32_t version;
+	int32_t gridSize;
+	int32_t winLength;
+	int32_t maxPly; //          
+	uint32_t entrySize;
+	uint64_t entryCount;
+};
+
+struct BookEntry {
+	uint64_t key;
+	uint16_t move; //   
+	uint16_t games; //      ,   UINT16_MAX
+	uint16_t score; //       :  1000,  500
+	uint16_t reserved;
+};
+
+//,   
+struct OpeningBook {
+	MappedFile file;
+	const BookHeader* header;
+	const BookEntry* entries;
+};
+
+bool OpenOpeningBook(const std::string& path, OpeningBook& book);
+void CloseOpeningBook(OpeningBook& book);
+
+//      -1,     
+int ProbeBook(const OpeningBook& book, const Board& board);
+
+//     (. GameLog.h)     k.
+//    maxPly ,    minGames ,  
+//       minGames ,     -  
+struct BookBuildOptions {
+	int gridSize;
+	int winLength;
+	int maxPly;
+	int minGames;
+};
+
+struct BookBuildStats {
+	uint64_t games; //   
+	uint64_t positions; //   maxPly
+	uint64_t entries; //  
+};
+
+bool BuildOpeningBook(const std::vector<std::string>& logPaths, const BookBuildOptions& options, const std::string& path, BookBuildStats& stats);
@@ -0,0 +1,135 @@
+#include "Patterns.h"
+
+// ,    n    ,     k - n
+constexpr int PATTERN_WEIGHTS[] = { 4000, 512, 64, 8, 1, 0 };
+
+//   .         
+constexpr int PatternWeight(int bits, int k) {
+	int count = 0, first = -1, last = -1;
+	for (int i = 0; i < k; i++) {
+		if ((bits >> i) & 1) {
+			count++;
+			if (first < 0)
+				first = i;
+			last = i;
+		}
+	}
+	if (count == 0)
+		return 0;
+	int weight = PATTERN_WEIGHTS[k - count];
+	if (count >= 2 && last - first + 1 == count)
+		weight += weight / 2;
+	return weight;
+}
+
+template <int K>
+struct PatternTable {
+	int16_t scores[1 << (2 * K)];
+};
+
+//         
+template <int K>
+constexpr PatternTable<K> MakePatternTable() {
+	PatternTable<K> table = {};
+	for (int x = 0; x < (1 << K); x++) {
+		for (int o = 0; o < (1 << K); o++) {
+			int score = 0;
+			if (o == 0)
+				score = PatternWeight(x, K);
+			else if (x == 0)
+				score = -PatternWeight(o, K);
+			table.scores[x | (o << K)] = (int16_t)score;
+		}
+	}
+	return table;
+}
+
+static constexpr PatternTable<3> patterns3 = MakePatternTable<3>();
+static constexpr PatternTable<4> patterns4 = MakePatternTable<4>();
+static constexpr PatternTable<5> patterns5 = MakePatternTable<5>();
+static_assert(MAX_TABLE_WIN_LENGTH == 5, "    k = 3, 4, 5");
+
+static const int16_t* GetPatternScores(int winLength) {
+	switch (winLength) {
+	case 3:
+		return patterns3.scores;
+	case 4:
+		return patterns4.scores;
+	case 5:
+		return patterns5.scores;
+	}
+	return NULL;
+}
+
+//    -      
+static int SlotInLine(const WinLineView& lines, int line, int cell) {
+	const uint64_t* mask = lines.masks + line * lines.words;
+	int slot = 0;
+	for (int w = 0; w < cell >> 6; w++)
+		slot += PopCount(mask[w]);
+	return slot + PopCount(mask[cell >> 6] & ((1ULL << (cell & 63)) - 1));
+}
+
+//         k,      
+void InitPatterns(PatternEval& eval, const Board& board) {
+	const WinLineView* lines = GetWinLines(board.size, board.winLength);
+	if (lines != eval.lines || eval.size != board.size || eval.winLength != board.winLength) {
+		eval.lines = lines;
+		eval.scores = GetPatternScores(board.winLength);
+		eval.size = board.size;
+		eval.winLength = board.winLength;
+		eval.slots.clear();
+		if (lines) {
+			int cells = board.size * board.size;
+			eval.slots.assign(cells * lines->perCell, 0);
+			for (int cell = 0; cell < cells; cell++) {
+				for (int i = 0; i < lines->cellLineCount[cell]; i++)
+					eval.slots[cell * lines->perCell + i] = (uint8_t)SlotInLine(*lines, lines->cellLines[cell * lines->perCell + i], cell);
+			}
+		}
+	}
+
+	eval.score = 0;
+	if (!eval.lines)
+		return;
+	eval.packed.assign(eval.lines->count, 0);
+	for (int cell = 0; cell < board.size * board.size; cell++) {
+		if (TestBit(board.stones[SIDE_X], cell))
+			PatternMove(eval, cell, SIDE_X);
+		else if (TestBit(board.stones[SIDE_O], cell))
+			PatternMove(eval, cell, SIDE_O);
+	}
+}
+
+void PatternMove(PatternEval& eval, int cell, int side) {
+	int shift = side == SIDE_X ? 0 : eval.winLength;
+	const uint16_t* cellLines = eval.lines->cellLines + cell * eval.lines->perCell;
+	const uint8_t* slots = eval.slots.data() + cell * eval.lines->perCell;
+	for (int i = 0; i < eval.lines->cellLineCount[cell]; i++) {
+		uint16_t& packed = eval.packed[cellLines[i]];
+		eval.score -= eval.scores[packed];
+		packed |= (uint16_t)(1 << (slots[i] + shift));
+		eval.score += eval.scores[packed];
+	}
+}
+
+void PatternUndo(PatternEval& eval, int cell, int side) {
+	int shift = side == SIDE_X ? 0 : eval.winLength;
+	const uint16_t* cellLines = eval.lines->cellLines + cell * eval.lines->perCell;
+	const uint8_t* slots = eval.slots.data() + cell * eval.lines->perCell;
+	for (int i = 0; i < eval.lines->cellLineCount[cell]; i++) {
+		uint16_t& packed = eval.packed[cellLines[i]];
+		eval.score -= eval.scores[packed];
+		packed &= (uint16_t)~(1 << (slots[i] + shift));
+		eval.score += eval.scores[packed];
+	}
+}
+
+int PatternScore(const PatternEval& eval, int side) {
+	int score = side == SIDE_X ? eval.score : -eval.score;
+	if (score > PATTERN_SCORE_LIMIT)
+		return PATTERN_SCORE_LIMIT;
+	if (score < -PATTERN_SCORE_LIMIT)
+		return -PATTERN_SCORE_LIMIT;
+	return score;
+}
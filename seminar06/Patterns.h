@@ -0,0 +1,28 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include "Board.h"
+#include "WinLines.h"
+
+//  :     k  (. WinLines.h)   
+//xBits | oBits << k,         .   
+//   ,  -   ,    .
+//       
+const int PATTERN_SCORE_LIMIT = 10000; //     Engine.h
+
+struct PatternEval {
+	const WinLineView* lines; //NULL,     :    
+	const int16_t* scores; //scores[ ],   X
+	int size;
+	int winLength;
+	std::vector<uint16_t> packed; //  
+	std::vector<uint8_t> slots; //slots[cell * perCell + i] -    i-   
+	int score; //     X
+};
+
+void InitPatterns(PatternEval& eval, const Board& board);
+void PatternMove(PatternEval& eval, int cell, int side);
+void PatternUndo(PatternEval& eval, int cell, int side);
+
+//   side,     PATTERN_SCORE_LIMIT
+int PatternScore(const PatternEval& eval, int side);
@@ -0,0 +1,487 @@
+#include <Windows.h>
+#include <algorithm>
+#include "ProofSearch.h"
+
+const uint64_t ATTACKER_O_KEY = 0x6A09E667F3BCC909ULL; //  ,    O
+const int TIME_CHECK_INTERVAL = 1024; //     
+const uint32_t PROOF_MAGIC = 0x50545454; //"TTTP"
+const uint32_t PROOF_VERSION = 1;
+const DWORD PROOF_IO_CHUNK = 1 << 24; //WriteFile  ReadFile    4   
+
+//  ,     
+struct ProofCheckpointHeader {
+	uint32_t magic;
+	uint32_t version;
+	uint8_t gridSize;
+	uint8_t winLength;
+	uint16_t moveCount;
+	uint32_t entrySize; //sizeof(ProofEntry)   
+	uint64_t bucketCount;
+	uint64_t used;
+	uint64_t totalNodes;
+	uint16_t moves[PROOF_MAX_CELLS];
+};
+
+void InitSolver(ProofSolver& solver, int tableMegabytes) {
+	size_t bytes = (size_t)tableMegabytes << 20;
+	size_t buckets = 1;
+	while (buckets * 2 * PROOF_BUCKET_SIZE * sizeof(ProofEntry) <= bytes)
+		buckets *= 2;
+
+	solver.table.assign(buckets * PROOF_BUCKET_SIZE, ProofEntry());
+	solver.bucketMask = buckets - 1;
+	solver.used = 0;
+	solver.totalNodes = 0;
+	solver.stop = false;
+	solver.nodes = 0;
+	solver.nodeLimit = 0;
+	solver.hasDeadline = false;
+	solver.progressMs = 0;
+}
+
+void ClearSolver(ProofSolver& solver) {
+	std::fill(solver.table.begin(), solver.table.end(), ProofEntry());
+	solver.used = 0;
+	solver.totalNodes = 0;
+}
+
+//    ,   SparseBoard:      
+static uint64_t CellKey(int cell, int side) {
+	uint64_t z = ((uint64_t)cell * 2 + side + 1) * 0x9E3779B97F4A7C15ULL;
+	z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+	z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+	return z ^ (z >> 31);
+}
+
+static void PlaySymmetric(const ProofSolver& solver, const SymmetryKeys& keys, int cell, int side, SymmetryKeys& child) {
+	const uint16_t* transforms = solver.transforms.data() + cell * PROOF_SYMMETRIES;
+	for (int i = 0; i < PROOF_SYMMETRIES; i++)
+		child.hashes[i] = keys.hashes[i] ^ CellKey(transforms[i], side);
+}
+
+//  ,   -   
+static uint64_t ProofKey(const ProofSolver& solver, const SymmetryKeys& keys) {
+	uint64_t key = keys.hashes[0];
+	for (int i = 1; i < PROOF_SYMMETRIES; i++)
+		key = std::min(key, keys.hashes[i]);
+	return solver.attacker == SIDE_X ? key : key ^ ATTACKER_O_KEY;
+}
+
+static void ChildKeys(const ProofSolver& solver, const Board& board, const SymmetryKeys& keys, const int* moves, int count, uint64_t* childKeys) {
+	for (int i = 0; i < count; i++) {
+		SymmetryKeys child;
+		PlaySymmetric(solver, keys, moves[i], board.sideToMove, child);
+		childKeys[i] = ProofKey(solver, child);
+	}
+}
+
+//    ,   
+static bool LookupNumbers(const ProofSolver& solver, uint64_t key, uint32_t& phi, uint32_t& delta) {
+	const ProofEntry* bucket = &solver.table[(key & solver.bucketMask) * PROOF_BUCKET_SIZE];
+	for (int i = 0; i < PROOF_BUCKET_SIZE; i++) {
+		if (bucket[i].key == key && bucket[i].work) {
+			phi = bucket[i].phi;
+			delta = bucket[i].delta;
+			return true;
+		}
+	}
+	return false;
+}
+
+static void StoreNumbers(ProofSolver& solver, uint64_t key, uint32_t phi, uint32_t delta, uint64_t work) {
+	ProofEntry* bucket = &solver.table[(key & solver.bucketMask) * PROOF_BUCKET_SIZE];
+	ProofEntry* victim = &bucket[0];
+	for (int i = 0; i < PROOF_BUCKET_SIZE; i++) {
+		if (bucket[i].key == key || bucket[i].work == 0) {
+			victim = &bucket[i];
+			break;
+		}
+		if (bucket[i].work < victim->work)
+			victim = &bucket[i];
+	}
+	if (victim->work == 0)
+		solver.used++;
+	victim->key = key;
+	victim->phi = phi;
+	victim->delta = delta;
+	victim->work = std::max<uint64_t>(work, 1);
+}
+
+static uint32_t AddNumbers(uint64_t a, uint64_t b) {
+	return (uint32_t)std::min<uint64_t>(a + b, PROOF_INFINITY - 1);
+}
+
+//      
+static bool HasOpenLine(const WinLineView& lines, const Board& board, int side) {
+	for (int line = 0; line < lines.count; line++) {
+		const uint64_t* mask = lines.masks + line * lines.words;
+		uint64_t blocked = 0;
+		for (int w = 0; w < lines.words; w++)
+			blocked |= mask[w] & board.stones[side ^ 1].words[w];
+		if (!blocked)
+			return true;
+	}
+	return false;
+}
+
+//  .      ;   ,
+//    ,     .  true   
+static bool ExpandNode(const ProofSolver& solver, const Board& board, int* moves, int& count, uint32_t& phi, uint32_t& delta) {
+	int mover = board.sideToMove;
+	count = GenerateMoves(board, moves);
+	if (count == 0) {
+		// :     
+		phi = mover == solver.attacker ? PROOF_INFINITY : 0;
+		delta = mover == solver.attacker ? 0 : PROOF_INFINITY;
+		return true;
+	}
+
+	int threat = -1, threats = 0;
+	for (int i = 0; i < count; i++) {
+		if (IsWinningMove(board, moves[i], mover)) {
+			phi = 0;
+			delta = PROOF_INFINITY;
+			return true;
+		}
+		if (IsWinningMove(board, moves[i], mover ^ 1)) {
+			threat = moves[i];
+			threats++;
+		}
+	}
+
+	//    :     ,   
+	if (solver.lines && !HasOpenLine(*solver.lines, board, solver.attacker)) {
+		phi = mover == solver.attacker ? PROOF_INFINITY : 0;
+		delta = mover == solver.attacker ? 0 : PROOF_INFINITY;
+		return true;
+	}
+	if (threats >= 2) {
+		phi = PROOF_INFINITY;
+		delta = 0;
+		return true;
+	}
+	if (threats == 1) {
+		moves[0] = threat;
+		count = 1;
+	}
+	return false;
+}
+
+static void ReportProgress(ProofSolver& solver, std::chrono::steady_clock::time_point now);
+
+static bool ShouldStop(ProofSolver& solver) {
+	if (solver.nodeLimit && solver.nodes >= solver.nodeLimit)
+		solver.stop = true;
+	else if ((solver.nodes & (TIME_CHECK_INTERVAL - 1)) == 0 && (solver.hasDeadline || solver.onProgress)) {
+		auto now = std::chrono::steady_clock::now();
+		if (solver.hasDeadline && now >= solver.deadline)
+			solver.stop = true;
+		else if (solver.onProgress && now >= solver.nextProgress)
+			ReportProgress(solver, now);
+	}
+	return solver.stop;
+}
+
+//   : phi -  delta , delta -  phi .
+//    ,   -     ,   ,
+//     ,   .   -  1/1
+static void CollectNumbers(const ProofSolver& solver, const uint64_t* keys, int count, uint32_t* childPhi, uint32_t* childDelta,
+	uint32_t& phi, uint32_t& delta, int& best, uint32_t& secondDelta) {
+	uint64_t sum = 0;
+	bool infinite = false;
+	phi = PROOF_INFINITY;
+	secondDelta = PROOF_INFINITY;
+	best = 0;
+	for (int i = 0; i < count; i++) {
+		LookupNumbers(solver, keys[i], childPhi[i], childDelta[i]);
+		if (childPhi[i] >= PROOF_INFINITY)
+			infinite = true;
+		sum += childPhi[i];
+		if (childDelta[i] < phi) {
+			secondDelta = phi;
+			phi = childDelta[i];
+			best = i;
+		}
+		else if (childDelta[i] < secondDelta)
+			secondDelta = childDelta[i];
+	}
+	delta = infinite ? PROOF_INFINITY : AddNumbers(sum, 0);
+}
+
+// ,      .      
+static void Mid(ProofSolver& solver, Board& board, const SymmetryKeys& keys, uint32_t thresholdPhi, uint32_t thresholdDelta, uint32_t& phi, uint32_t& delta) {
+	solver.nodes++;
+	uint64_t startNodes = solver.nodes;
+	uint64_t key = ProofKey(solver, keys);
+
+	int moves[PROOF_MAX_CELLS];
+	int count;
+	if (ExpandNode(solver, board, moves, count, phi, delta)) {
+		StoreNumbers(solver, key, phi, delta, 1);
+		return;
+	}
+
+	uint64_t childKeys[PROOF_MAX_CELLS];
+	uint32_t childPhi[PROOF_MAX_CELLS], childDelta[PROOF_MAX_CELLS];
+	ChildKeys(solver, board, keys, moves, count, childKeys);
+	for (int i = 0; i < count; i++) {
+		childPhi[i] = 1;
+		childDelta[i] = 1;
+	}
+
+	for (;;) {
+		int best;
+		uint32_t secondDelta;
+		CollectNumbers(solver, childKeys, count, childPhi, childDelta, phi, delta, best, secondDelta);
+		if (phi >= thresholdPhi || delta >= thresholdDelta || ShouldStop(solver))
+			break;
+
+		//    delta   1/4 ( 1+eps):       
+		uint32_t thresholdChildPhi = AddNumbers((uint64_t)thresholdDelta - delta, childPhi[best]);
+		uint32_t thresholdChildDelta = (uint32_t)std::min<uint64_t>(thresholdPhi, AddNumbers(secondDelta + 1, secondDelta / 4));
+		SymmetryKeys child;
+		PlaySymmetric(solver, keys, moves[best], board.sideToMove, child);
+		MakeMove(board, moves[best]);
+		Mid(solver, board, child, thresholdChildPhi, thresholdChildDelta, childPhi[best], childDelta[best]);
+		UndoMove(board);
+	}
+	StoreNumbers(solver, key, phi, delta, solver.nodes - startNodes + 1);
+}
+
+//    :         Mid
+static void RootNumbers(ProofSolver& solver, uint32_t& phi, uint32_t& delta) {
+	int moves[PROOF_MAX_CELLS];
+	int count;
+	if (ExpandNode(solver, solver.root, moves, count, phi, delta))
+		return;
+
+	uint64_t childKeys[PROOF_MAX_CELLS];
+	uint32_t childPhi[PROOF_MAX_CELLS], childDelta[PROOF_MAX_CELLS];
+	ChildKeys(solver, solver.root, solver.rootKeys, moves, count, childKeys);
+	for (int i = 0; i < count; i++) {
+		childPhi[i] = 1;
+		childDelta[i] = 1;
+	}
+	int best;
+	uint32_t secondDelta;
+	CollectNumbers(solver, childKeys, count, childPhi, childDelta, phi, delta, best, secondDelta);
+}
+
+static void ReportProgress(ProofSolver& solver, std::chrono::steady_clock::time_point now) {
+	ProofProgress progress;
+	progress.attacker = solver.attacker;
+	RootNumbers(solver, progress.phi, progress.delta);
+	progress.nodes = solver.totalNodes + solver.nodes;
+	progress.tableUsed = solver.used;
+	progress.tableSize = solver.table.size();
+	progress.seconds = std::chrono::duration<double>(now - solver.start).count();
+	solver.onProgress(progress);
+	solver.nextProgress = now + std::chrono::milliseconds(solver.progressMs);
+}
+
+//  attacker.       :
+//0 - ,  - .     ,   delta
+static uint32_t Prove(ProofSolver& solver, int attacker) {
+	solver.attacker = attacker;
+	Board board = solver.root;
+	uint32_t phi, delta;
+	Mid(solver, board, solver.rootKeys, PROOF_INFINITY, PROOF_INFINITY, phi, delta);
+	if (solver.stop)
+		return 1;
+	return board.sideToMove == attacker ? phi : delta;
+}
+
+//,      :  phi .    ,   
+static int FindProvenMove(ProofSolver& solver, int attacker) {
+	solver.attacker = attacker;
+	Board board = solver.root;
+	int moves[PROOF_MAX_CELLS];
+	int count;
+	uint32_t phi, delta;
+	ExpandNode(solver, board, moves, count, phi, delta);
+	if (count == 0)
+		return -1;
+
+	for (int i = 0; i < count; i++) {
+		if (IsWinningMove(board, moves[i], board.sideToMove))
+			return moves[i];
+	}
+	//       ,     
+	uint64_t childKeys[PROOF_MAX_CELLS];
+	ChildKeys(solver, board, solver.rootKeys, moves, count, childKeys);
+	for (int i = 0; i < count; i++) {
+		if (LookupNumbers(solver, childKeys[i], phi, delta) && phi >= PROOF_INFINITY)
+			return moves[i];
+	}
+
+	for (int i = 0; i < count; i++) {
+		SymmetryKeys child;
+		PlaySymmetric(solver, solver.rootKeys, moves[i], board.sideToMove, child);
+		MakeMove(board, moves[i]);
+		Mid(solver, board, child, PROOF_INFINITY, PROOF_INFINITY, phi, delta);
+		UndoMove(board);
+		if (solver.stop)
+			return -1;
+		if (phi >= PROOF_INFINITY)
+			return moves[i];
+	}
+	return -1;
+}
+
+ProofResult SolvePosition(ProofSolver& solver, const Board& board, const ProofLimits& limits, const ProofProgressCallback& onProgress) {
+	solver.start = std::chrono::steady_clock::now();
+	solver.stop = false;
+	solver.nodes = 0;
+	solver.nodeLimit = limits.nodes;
+	solver.hasDeadline = limits.timeMs > 0;
+	solver.deadline = solver.start + std::chrono::milliseconds(limits.timeMs);
+	solver.progressMs = limits.progressMs > 0 ? limits.progressMs : 1000;
+	solver.nextProgress = solver.start + std::chrono::milliseconds(solver.progressMs);
+	solver.onProgress = onProgress;
+	solver.root = board;
+	solver.lines = GetWinLines(board.size, board.winLength);
+
+	int cells = board.size * board.size;
+	solver.transforms.resize(cells * PROOF_SYMMETRIES);
+	for (int cell = 0; cell < cells; cell++) {
+		for (int i = 0; i < PROOF_SYMMETRIES; i++)
+			solver.transforms[cell * PROOF_SYMMETRIES + i] = (uint16_t)TransformCell(cell, board.size, i);
+	}
+	SymmetryKeys empty = {};
+	solver.rootKeys = empty;
+	for (int cell = 0; cell < cells; cell++) {
+		for (int side = SIDE_X; side <= SIDE_O; side++) {
+			if (TestBit(board.stones[side], cell))
+				PlaySymmetric(solver, solver.rootKeys, cell, side, solver.rootKeys);
+		}
+	}
+
+	ProofResult result = { GetResult(board), -1, 0, 0.0 };
+	if (result.result == RESULT_NONE && board.size <= PROOF_MAX_SIZE) {
+		int mover = board.sideToMove;
+		if (Prove(solver, mover) == 0) {
+			result.result = mover == SIDE_X ? RESULT_X_WIN : RESULT_O_WIN;
+			result.bestMove = FindProvenMove(solver, mover);
+		}
+		else if (!solver.stop) {
+			//   : ,    .   - 
+			uint32_t proof = Prove(solver, mover ^ 1);
+			if (!solver.stop && proof == 0) {
+				// :  ,     ,  
+				result.result = mover == SIDE_X ? RESULT_O_WIN : RESULT_X_WIN;
+				int moves[PROOF_MAX_CELLS];
+				int count;
+				uint32_t phi, delta;
+				ExpandNode(solver, board, moves, count, phi, delta);
+				if (count > 0)
+					result.bestMove = moves[0];
+			}
+			else if (!solver.stop) {
+				result.result = RESULT_DRAW;
+				result.bestMove = FindProvenMove(solver, mover ^ 1);
+			}
+		}
+		if (solver.stop)
+			result.result = RESULT_NONE;
+	}
+
+	solver.onProgress = nullptr;
+	result.nodes = solver.nodes;
+	solver.totalNodes += solver.nodes;
+	solver.nodes = 0;
+	result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - solver.start).count();
+	return result;
+}
+
+static bool WriteAll(HANDLE hFile, const void* data, uint64_t size) {
+	const char* bytes = (const char*)data;
+	while (size > 0) {
+		DWORD chunk = (DWORD)std::min<uint64_t>(size, PROOF_IO_CHUNK);
+		DWORD written = 0;
+		if (!WriteFile(hFile, bytes, chunk, &written, NULL) || written != chunk)
+			return false;
+		bytes += chunk;
+		size -= chunk;
+	}
+	return true;
+}
+
+static bool ReadAll(HANDLE hFile, void* data, uint64_t size) {
+	char* bytes = (char*)data;
+	while (size > 0) {
+		DWORD chunk = (DWORD)std::min<uint64_t>(size, PROOF_IO_CHUNK);
+		DWORD read = 0;
+		if (!ReadFile(hFile, bytes, chunk, &read, NULL) || read != chunk)
+			return false;
+		bytes += chunk;
+		size -= chunk;
+	}
+	return true;
+}
+
+//     ,       
+bool SaveProofCheckpoint(const ProofSolver& solver, const Board& board, const std::string& path) {
+	ProofCheckpointHeader header = {};
+	header.magic = PROOF_MAGIC;
+	header.version = PROOF_VERSION;
+	header.gridSize = (uint8_t)board.size;
+	header.winLength = (uint8_t)board.winLength;
+	header.moveCount = (uint16_t)board.moveCount;
+	header.entrySize = sizeof(ProofEntry);
+	header.bucketCount = solver.bucketMask + 1;
+	header.used = solver.used;
+	header.totalNodes = solver.totalNodes + solver.nodes;
+	for (int i = 0; i < board.moveCount; i++)
+		header.moves[i] = board.moves[i];
+
+	std::string tempPath = path + ".tmp";
+	HANDLE hFile = CreateFileA(tempPath.c_str(), GENERIC_WRITE, 0, NULL, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, NULL);
+	if (hFile == INVALID_HANDLE_VALUE)
+		return false;
+
+	bool ok = WriteAll(hFile, &header, sizeof(header)) &&
+		WriteAll(hFile, solver.table.data(), solver.table.size() * sizeof(ProofEntry));
+	CloseHandle(hFile);
+
+	if (!ok) {
+		DeleteFileA(tempPath.c_str());
+		return false;
+	}
+	return MoveFileExA(tempPath.c_str(), path.c_str(), MOVEFILE_REPLACE_EXISTING) != 0;
+}
+
+//     ,   
+bool LoadProofCheckpoint(ProofSolver& solver, Board& board, const std::string& path) {
+	HANDLE hFile = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+	if (hFile == INVALID_HANDLE_VALUE)
+		return false;
+
+	ProofCheckpointHeader header;
+	bool ok = ReadAll(hFile, &header, sizeof(header)) &&
+		header.magic == PROOF_MAGIC && header.version == PROOF_VERSION && header.entrySize == sizeof(ProofEntry) &&
+		header.gridSize >= 3 && header.gridSize <= PROOF_MAX_SIZE && header.winLength >= 1 && header.winLength <= header.gridSize &&
+		header.moveCount <= header.gridSize * header.gridSize &&
+		header.bucketCount > 0 && (header.bucketCount & (header.bucketCount - 1)) == 0;
+
+	if (ok) {
+		InitBoard(board, header.gridSize, header.winLength);
+		for (int i = 0; ok && i < header.moveCount; i++) {
+			int cell = header.moves[i];
+			ok = cell < board.size * board.size && IsEmptyCell(board, cell) && GetResult(board) == RESULT_NONE;
+			if (ok)
+				MakeMove(board, cell);
+		}
+	}
+
+	if (ok) {
+		solver.table.resize(header.bucketCount * PROOF_BUCKET_SIZE);
+		ok = ReadAll(hFile, solver.table.data(), solver.table.size() * sizeof(ProofEntry));
+		solver.bucketMask = header.bucketCount - 1;
+		solver.used = header.used;
+		solver.totalNodes = header.totalNodes;
+		if (!ok)
+			ClearSolver(solver);
+	}
+	CloseHandle(hFile);
+	return ok;
+}
@@ -0,0 +1,88 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <string>
+#include <vector>
+#include "Board.h"
+#include "WinLines.h"
+
+// df-pn (     ):      .
+//    phi/delta   ,  : phi -    ,
+//   , delta -  .   - ,  -   .
+//   ,  ,   ;   ,   - 
+const uint32_t PROOF_INFINITY = 0x7FFFFFFF;
+const int PROOF_MAX_SIZE = 8; //   ,             
+const int PROOF_MAX_CELLS = PROOF_MAX_SIZE * PROOF_MAX_SIZE;
+const int PROOF_BUCKET_SIZE = 4; //   ,     
+const int PROOF_SYMMETRIES = BOARD_SYMMETRIES;
+
+// :   ,      
+struct ProofEntry {
+	uint64_t key;
+	uint32_t phi;
+	uint32_t delta;
+	uint64_t work; //,      
+};
+
+//,  -  .        
+struct ProofLimits {
+	uint64_t nodes;
+	int timeMs;
+	int progressMs; //   onProgress
+};
+
+struct ProofProgress {
+	int attacker; //   
+	uint32_t phi; // ,     
+	uint32_t delta;
+	uint64_t nodes;
+	uint64_t tableUsed;
+	uint64_t tableSize;
+	double seconds;
+};
+
+typedef std::function<void(const ProofProgress&)> ProofProgressCallback;
+
+struct ProofResult {
+	int result; //RESULT_X_WIN, RESULT_O_WIN, RESULT_DRAW  RESULT_NONE,       PROOF_MAX_SIZE
+	int bestMove; //,  , -1   
+	uint64_t nodes;
+	double seconds;
+};
+
+//    ,   
+struct SymmetryKeys {
+	uint64_t hashes[PROOF_SYMMETRIES];
+};
+
+struct ProofSolver {
+	std::vector<ProofEntry> table;
+	uint64_t bucketMask;
+	uint64_t used; // 
+	uint64_t totalNodes; //   ,     
+	std::atomic<bool> stop;
+
+	//   
+	int attacker;
+	uint64_t nodes;
+	uint64_t nodeLimit;
+	bool hasDeadline;
+	std::chrono::steady_clock::time_point start;
+	std::chrono::steady_clock::time_point deadline;
+	std::chrono::steady_clock::time_point nextProgress;
+	int progressMs;
+	ProofProgressCallback onProgress;
+	Board root;
+	SymmetryKeys rootKeys;
+	std::vector<uint16_t> transforms; //transforms[cell * PROOF_SYMMETRIES + i] -   i- 
+	const WinLineView* lines; // ,      ; NULL -  
+};
+
+void InitSolver(ProofSolver& solver, int tableMegabytes);
+void ClearSolver(ProofSolver& solver);
+ProofResult SolvePosition(ProofSolver& solver, const Board& board, const ProofLimits& limits, const ProofProgressCallback& onProgress);
+
+// :    .     
+bool SaveProofCheckpoint(const ProofSolver& solver, const Board& board, const std::string& path);
+bool LoadProofCheckpoint(ProofSolver& solver, Board& board, const std::string& path);
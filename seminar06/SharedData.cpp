@@ -0,0 +1,60 @@
+#include <cstring>
+#include "SharedData.h"
+
+//     :  ,   .
+//           .   
+LONG64 PublishSharedWrite(SharedData& shared) {
+	LARGE_INTEGER now;
+	QueryPerformanceCounter(&now);
+	InterlockedExchange64(&shared.writeTicks, now.QuadPart);
+	return InterlockedIncrement64(&shared.version);
+}
+
+//    :  gridSize x gridSize   
+void BuildSnapshot(const SharedData& shared, int gridSize, GameSnapshot& snapshot) {
+	memset(&snapshot, 0, sizeof(snapshot));
+	snapshot.magic = SNAPSHOT_MAGIC;
+	snapshot.version = SNAPSHOT_VERSION;
+	snapshot.snapshotSize = sizeof(GameSnapshot);
+	snapshot.gridSize = (uint8_t)gridSize;
+	snapshot.backColor = shared.backColor;
+	snapshot.lineColor = shared.lineColor;
+
+	for (int y = 0; y < gridSize; ++y) {
+		for (int x = 0; x < gridSize; ++x) {
+			if (shared.board[y][x] == 'X')
+				SetBit(snapshot.stones[SIDE_X], y * gridSize + x);
+			else if (shared.board[y][x] == 'O')
+				SetBit(snapshot.stones[SIDE_O], y * gridSize + x);
+		}
+	}
+
+	//      ,     
+	for (int i = 0; i < shared.moveCount; i++) {
+		int cell = MoveCell(shared.moves[i]);
+		int x = cell % MAX_GRID_SIZE, y = cell / MAX_GRID_SIZE;
+		if (x < gridSize && y < gridSize)
+			snapshot.moves[snapshot.moveCount++] = PackMove(y * gridSize + x, MoveSide(shared.moves[i]));
+	}
+}
+
+//     
+void RestoreSnapshot(const GameSnapshot& snapshot, SharedData& shared) {
+	int size = snapshot.gridSize;
+	for (int cell = 0; cell < size * size; cell++) {
+		char& tile = shared.board[cell / size][cell % size];
+		if (TestBit(snapshot.stones[SIDE_X], cell))
+			tile = 'X';
+		else if (TestBit(snapshot.stones[SIDE_O], cell))
+			tile = 'O';
+	}
+
+	shared.moveCount = snapshot.moveCount;
+	for (int i = 0; i < snapshot.moveCount; i++) {
+		int cell = MoveCell(snapshot.moves[i]);
+		shared.moves[i] = PackMove(cell / size * MAX_GRID_SIZE + cell % size, MoveSide(snapshot.moves[i]));
+	}
+
+	shared.backColor = snapshot.backColor;
+	shared.lineColor = snapshot.lineColor;
+}
@@ -0,0 +1,19 @@
+#pragma once
+#include <Windows.h>
+#include "Board.h"
+#include "Snapshot.h"
+
+//    
+struct SharedData {
+	char board[MAX_GRID_SIZE][MAX_GRID_SIZE];
+	COLORREF backColor;
+	COLORREF lineColor;
+	int moveCount; //   
+	MoveEntry moves[MAX_CELLS]; // ,  = y * MAX_GRID_SIZE + x
+	volatile LONG64 version; //      
+	volatile LONG64 writeTicks; //QueryPerformanceCounter    
+};
+
+LONG64 PublishSharedWrite(SharedData& shared);
+void BuildSnapshot(const SharedData& shared, int gridSize, GameSnapshot& snapshot);
+void RestoreSnapshot(const GameSnapshot& snapshot, SharedData& shared);
@@ -0,0 +1,90 @@
+#include "Snapshot.h"
+
+//    
+bool IsValidSnapshot(const GameSnapshot& snapshot) {
+	if (snapshot.magic != SNAPSHOT_MAGIC || snapshot.version != SNAPSHOT_VERSION || snapshot.snapshotSize != sizeof(GameSnapshot))
+		return false;
+
+	if (snapshot.gridSize == 0 || snapshot.gridSize > MAX_GRID_SIZE)
+		return false;
+
+	int cells = snapshot.gridSize * snapshot.gridSize;
+	if (snapshot.moveCount > cells)
+		return false;
+
+	for (int i = 0; i < snapshot.moveCount; i++) {
+		if (MoveCell(snapshot.moves[i]) >= cells)
+			return false;
+	}
+
+	//     ,   , 
+	for (int i = 0; i < BITBOARD_WORDS; i++) {
+		if (snapshot.stones[SIDE_X].words[i] & snapshot.stones[SIDE_O].words[i])
+			return false;
+	}
+	for (int cell = cells; cell < BITBOARD_WORDS * 64; cell++) {
+		if (TestBit(snapshot.stones[SIDE_X], cell) || TestBit(snapshot.stones[SIDE_O], cell))
+			return false;
+	}
+
+	return true;
+}
+
+static bool WriteAll(HANDLE hFile, const GameSnapshot& snapshot) {
+	DWORD written = 0;
+	return WriteFile(hFile, &snapshot, sizeof(GameSnapshot), &written, NULL) && written == sizeof(GameSnapshot);
+}
+
+//  .      ,     
+bool WriteSnapshot(const std::string& path, const GameSnapshot& snapshot) {
+	std::string tempPath = path + ".tmp";
+
+	HANDLE hFile = CreateFileA(tempPath.c_str(), GENERIC_WRITE, 0, NULL, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, NULL);
+	if (hFile == INVALID_HANDLE_VALUE)
+		return false;
+
+	bool ok = WriteAll(hFile, snapshot);
+	CloseHandle(hFile);
+
+	if (!ok) {
+		DeleteFileA(tempPath.c_str());
+		return false;
+	}
+
+	return MoveFileExA(tempPath.c_str(), path.c_str(), MOVEFILE_REPLACE_EXISTING) != 0;
+}
+
+//    
+bool AppendSnapshot(const std::string& path, const GameSnapshot& snapshot) {
+	HANDLE hFile = CreateFileA(path.c_str(), FILE_APPEND_DATA, FILE_SHARE_READ, NULL, OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, NULL);
+	if (hFile == INVALID_HANDLE_VALUE)
+		return false;
+
+	bool ok = WriteAll(hFile, snapshot);
+	CloseHandle(hFile);
+	return ok;
+}
+
+//       
+bool OpenSnapshots(const std::string& path, SnapshotView& view) {
+	view.snapshots = NULL;
+	view.count = 0;
+
+	if (!OpenMappedFile(path, view.file))
+		return false;
+
+	if (view.file.size < sizeof(GameSnapshot)) {
+		CloseMappedFile(view.file);
+		return false;
+	}
+
+	view.snapshots = (const GameSnapshot*)view.file.data;
+	view.count = (size_t)(view.file.size / sizeof(GameSnapshot)); //   
+	return true;
+}
+
+void CloseSnapshots(SnapshotView& view) {
+	CloseMappedFile(view.file);
+	view.snapshots = NULL;
+	view.count = 0;
+}
@@ -0,0 +1,41 @@
+#pragma once
+#include <Windows.h>
+#include <string>
+#include "Board.h"
+#include "MappedFile.h"
+
+const uint32_t SNAPSHOT_MAGIC = 0x53545454; //"TTTS"
+const uint16_t SNAPSHOT_VERSION = 2; //    
+const int SNAPSHOT_MOVES = (MAX_CELLS + 3) / 4 * 4; //     8  
+
+//   .
+// ,    ,    .
+//       .
+struct GameSnapshot {
+	uint32_t magic;
+	uint16_t version;
+	uint16_t snapshotSize; //sizeof(GameSnapshot)   
+	uint8_t gridSize;
+	uint8_t unused; //    .    :  ,  ,      
+	uint16_t moveCount;
+	uint32_t backColor;
+	uint32_t lineColor;
+	uint32_t reserved; //    8 
+	Bitboard stones[2]; // X  O
+	MoveEntry moves[SNAPSHOT_MOVES]; // ,   moveCount
+};
+
+static_assert(sizeof(GameSnapshot) % 8 == 0, "     ");
+
+//     
+struct SnapshotView {
+	MappedFile file;
+	const GameSnapshot* snapshots;
+	size_t count;
+};
+
+bool IsValidSnapshot(const GameSnapshot& snapshot);
+bool WriteSnapshot(const std::string& path, const GameSnapshot& snapshot);
+bool AppendSnapshot(const std::string& path, const GameSnapshot& snapshot);
+bool OpenSnapshots(const std::string& path, SnapshotView& view);
+void CloseSnapshots(SnapshotView& view);
@@ -1,9 +1,20 @@
 #include <Windows.h>
+#include <algorithm>
+#include <cstdio>
 #include <fstream>
+#include <memory>
 #include "json.hpp"
+#include "AsyncEngine.h"
+#include "Board.h"
+#include "Histogram.h"
+#include "Metrics.h"
+#include "SharedData.h"
+#include "Snapshot.h"
+#include "Trace.h"
 using json = nlohmann::json;
 
 std::string configFile = "settings.json"; // 
+std::string sessionFile = "session.bin"; // ,  
 
 int baseWindowWidth = 320, baseWindowHeight = 240; //   
 int minWindowWidth = 200, minWindowHeight = 200; //  
@@ -16,19 +27,74 @@ COLORREF xColor = RGB(255, 255, 255); //
 COLORREF oColor = RGB(0, 0 ,0); //   
 
 int gridSize = 3; //   
-const int MAX_GRID_SIZE = 10; //  
+int metricsPort = 0; // HTTP   Prometheus  127.0.0.1, 0 -  
+MetricsServer metricsServer;
 char board[MAX_GRID_SIZE][MAX_GRID_SIZE]; //   X  O
 
-struct SharedData {
-	char board[MAX_GRID_SIZE][MAX_GRID_SIZE];
-	COLORREF backColor;
-	COLORREF lineColor;
-};
-
 const wchar_t lassName[] = L"TicTacToeWindowClass";
+const wchar_t windowTitle[] = L"  ";
 HANDLE hMapping = NULL;
 SharedData* sharedMemory = NULL;
 UINT WM_UPDATE_BOARD = RegisterWindowMessage(L"TicTacToe_UpdateBoard");
+uint64_t pendingPaintFlow = 0; // ,    WM_PAINT
+
+//     :         UpdateBoard   
+LONG64 seenVersion = 0; //   ,    
+LONG64 pendingPaintTicks = 0; //  ,   
+Histogram readLatency, paintLatency; //
+
+//   ,    .     ,    
+//   ,     WM_ENGINE_DONE
+bool engineEnabled = false; //  E
+int engineTimeMs = 1000; //   
+int winLength = 0; //     , 0 - min(gridSize, ENGINE_WIN_LENGTH)
+const int ENGINE_WIN_LENGTH = 5;
+const int ENGINE_TABLE_MEGABYTES = 16;
+AsyncEngine asyncEngine;
+const UINT WM_ENGINE_DONE = WM_APP + 1; //WPARAM -  , LPARAM - SearchResult*,  
+uint64_t engineSearchId = 0; //,   , 0 -  
+int engineSearchSide = SIDE_X; //   
+int engineSearchMoves = 0; // ,    
+
+//:          
+bool enginePonder = true;
+uint64_t ponderSearchId = 0; //0 -  
+MoveEntry ponderEntry = 0; //     
+int ponderMoves = 0; //    
+int ponderSide = SIDE_X; //    
+
+//  ,    FRAME_INTERVAL_MS. WM_TIMER ,   
+// ,     ,   
+const UINT_PTR FRAME_TIMER_ID = 1;
+const UINT FRAME_INTERVAL_MS = 16;
+LONG64 lastFrameTicks = 0;
+Histogram frameLatency; //  , 
+
+//      
+void SaveSession() {
+	if (!sharedMemory)
+		return;
+
+	GameSnapshot snapshot;
+	BuildSnapshot(*sharedMemory, gridSize, snapshot);
+	WriteSnapshot(sessionFile, snapshot);
+}
+
+//    ,   .      :
+//  ,       
+void LoadSession() {
+	SnapshotView view;
+	if (!OpenSnapshots(sessionFile, view))
+		return;
+
+	if (IsValidSnapshot(view.snapshots[0]) && view.snapshots[0].gridSize == gridSize) {
+		RestoreSnapshot(view.snapshots[0], *sharedMemory);
+		backColor = sharedMemory->backColor;
+		lineColor = sharedMemory->lineColor;
+	}
+
+	CloseSnapshots(view);
+}
 
 //  
 void InitSharedMemory(HWND hwnd) {
@@ -66,8 +132,17 @@ void InitSharedMemory(HWND hwnd) {
 		memset(sharedMemory->board, '.', sizeof(sharedMemory->board));
 		sharedMemory->backColor = backColor;
 		sharedMemory->lineColor = lineColor;
+		sharedMemory->moveCount = 0;
+
+		LoadSession(); // ,    
+		UpdateBackColor(hwnd, backColor);
 	}
 
+	seenVersion = sharedMemory->version;
+	ClearHistogram(readLatency);
+	ClearHistogram(paintLatency);
+	ClearHistogram(frameLatency);
+
 	//     
 	for (int y = 0; y < gridSize; ++y) {
 		for (int x = 0; x < gridSize; ++x) {
@@ -76,11 +151,35 @@ void InitSharedMemory(HWND hwnd) {
 	}
 }
 
+//   ticks  QueryPerformanceCounter  
+uint64_t NanosecondsSince(LONG64 ticks) {
+	static LARGE_INTEGER frequency = { 0 };
+	if (frequency.QuadPart == 0)
+		QueryPerformanceFrequency(&frequency);
+
+	LARGE_INTEGER now;
+	QueryPerformanceCounter(&now);
+	if (now.QuadPart <= ticks)
+		return 0;
+	return (uint64_t)((now.QuadPart - ticks) * (1e9 / (double)frequency.QuadPart));
+}
+
 // 
 void UpdateBoard(HWND hwnd) {
 	if (!sharedMemory) 
 		return;
 
+	TRACE_SPAN("UpdateBoard");
+
+	//    :     seenVersion .
+	//    ,    
+	LONG64 version = sharedMemory->version;
+	if (version != seenVersion) {
+		pendingPaintTicks = sharedMemory->writeTicks;
+		RecordValue(readLatency, NanosecondsSince(pendingPaintTicks));
+		seenVersion = version;
+	}
+
 	backColor = sharedMemory->backColor; 
 	lineColor = sharedMemory->lineColor; 
 	UpdateBackColor(hwnd, backColor);
@@ -92,15 +191,20 @@ void UpdateBoard(HWND hwnd) {
 	}
 }
 
-//      
+//      .
+//  WPARAM    ,   -     
 void NotifyAllWindows(HWND hwnd) {
-	
+	TRACE_SPAN("NotifyAllWindows");
+
 	EnumWindows([](HWND hwndTarget, LPARAM lParam) -> BOOL {
 		wchar_t className[256];
 		GetClassName(hwndTarget, className, 256);
 
 		if (wcscmp(className, lassName) == 0 && hwndTarget != (HWND)lParam) {
-			PostMessage(hwndTarget, WM_UPDATE_BOARD, 0, 0);
+			WPARAM flow = (WPARAM)TRACE_NEW_FLOW();
+			TRACE_FLOW_START("move", flow);
+			PostMessage(hwndTarget, WM_UPDATE_BOARD, flow, 0);
+			CountMetric(METRIC_NOTIFICATIONS);
 		}
 		return TRUE;
 	}, 
@@ -108,6 +212,143 @@ void NotifyAllWindows(HWND hwnd) {
 }
 
 
+//   : , ,   
+void PlaceMark(HWND hwnd, int boardX, int boardY, int side) {
+	if (sharedMemory) {
+		//        
+		if (sharedMemory->board[boardY][boardX] == '.' && sharedMemory->moveCount < MAX_CELLS) {
+			sharedMemory->moves[sharedMemory->moveCount++] = PackMove(boardY * MAX_GRID_SIZE + boardX, side);
+			CountMetric(METRIC_MOVES);
+		}
+
+		sharedMemory->board[boardY][boardX] = side == SIDE_O ? 'O' : 'X';
+		seenVersion = PublishSharedWrite(*sharedMemory);
+	}
+
+	//   
+	UpdateBoard(hwnd);
+
+	//     
+	NotifyAllWindows(hwnd);
+
+	InvalidateRect(hwnd, NULL, TRUE);
+}
+
+//     .  Board   X,     O,
+//   (swapped = 1). false,        
+bool BuildEngineBoard(Board& engineBoard, int& swapped) {
+	int k = winLength > 0 ? std::min(winLength, gridSize) : std::min(gridSize, ENGINE_WIN_LENGTH);
+	InitBoard(engineBoard, gridSize, k);
+	swapped = sharedMemory->moveCount > 0 && MoveSide(sharedMemory->moves[0]) == SIDE_O ? 1 : 0;
+	for (int i = 0; i < sharedMemory->moveCount; i++) {
+		int x = MoveCell(sharedMemory->moves[i]) % MAX_GRID_SIZE;
+		int y = MoveCell(sharedMemory->moves[i]) / MAX_GRID_SIZE;
+		if (x >= gridSize || y >= gridSize || (MoveSide(sharedMemory->moves[i]) ^ swapped) != engineBoard.sideToMove ||
+			!IsEmptyCell(engineBoard, y * gridSize + x))
+			return false;
+		MakeMove(engineBoard, y * gridSize + x);
+	}
+
+	for (int y = 0; y < gridSize; ++y) {
+		for (int x = 0; x < gridSize; ++x) {
+			char mark = sharedMemory->board[y][x];
+			int cell = y * gridSize + x;
+			if (mark == '.' ? !IsEmptyCell(engineBoard, cell) : !TestBit(engineBoard.stones[(mark == 'O' ? SIDE_O : SIDE_X) ^ swapped], cell))
+				return false;
+		}
+	}
+	return true;
+}
+
+//    :   ,      
+AsyncSearchCallback PostEngineResult(HWND hwnd) {
+	return [hwnd](const AsyncSearchDone& done) {
+		SearchResult* result = new SearchResult(done.result);
+		if (done.cancelled || !PostMessage(hwnd, WM_ENGINE_DONE, (WPARAM)done.id, (LPARAM)result))
+			delete result;
+	};
+}
+
+void StopPonder() {
+	if (!ponderSearchId)
+		return;
+	CancelSearch(asyncEngine);
+	ponderSearchId = 0;
+}
+
+//  ,   ,    ,    
+void BeginEngineMove(HWND hwnd) {
+	LARGE_INTEGER now;
+	QueryPerformanceCounter(&now);
+	lastFrameTicks = now.QuadPart;
+	SetTimer(hwnd, FRAME_TIMER_ID, FRAME_INTERVAL_MS, NULL);
+	SetWindowTextW(hwnd, (std::wstring(windowTitle) + L" -  ...").c_str());
+}
+
+//    :     ,      
+void FinishEngineMove(HWND hwnd) {
+	if (!engineSearchId)
+		return;
+	engineSearchId = 0;
+	KillTimer(hwnd, FRAME_TIMER_ID);
+	SetWindowTextW(hwnd, windowTitle);
+}
+
+void CancelEngineMove(HWND hwnd) {
+	StopPonder();
+	if (!engineSearchId)
+		return;
+	CancelSearch(asyncEngine);
+	FinishEngineMove(hwnd);
+}
+
+//        
+void StartEngineMove(HWND hwnd) {
+	//    :   ,      
+	if (ponderSearchId && engineEnabled && sharedMemory && sharedMemory->moveCount == ponderMoves &&
+		sharedMemory->moves[ponderMoves - 1] == ponderEntry && PonderHit(asyncEngine)) {
+		engineSearchId = ponderSearchId;
+		engineSearchSide = ponderSide;
+		engineSearchMoves = ponderMoves;
+		ponderSearchId = 0;
+		BeginEngineMove(hwnd);
+		return;
+	}
+	CancelEngineMove(hwnd);
+
+	Board engineBoard;
+	int swapped;
+	if (!engineEnabled || !sharedMemory || !BuildEngineBoard(engineBoard, swapped) || GetResult(engineBoard) != RESULT_NONE ||
+		engineBoard.moveCount == gridSize * gridSize)
+		return;
+
+	TRACE_SPAN("StartEngineMove");
+	SearchLimits limits = { 0, 0, engineTimeMs, 0, 0 };
+	engineSearchSide = engineBoard.sideToMove ^ swapped;
+	engineSearchMoves = sharedMemory->moveCount;
+	engineSearchId = StartSearch(asyncEngine, engineBoard, limits, PostEngineResult(hwnd));
+	BeginEngineMove(hwnd);
+}
+
+//  : predicted -      Board
+void StartEnginePonder(HWND hwnd, int predicted) {
+	Board engineBoard;
+	int swapped;
+	if (!enginePonder || predicted < 0 || !sharedMemory || !BuildEngineBoard(engineBoard, swapped) ||
+		GetResult(engineBoard) != RESULT_NONE || !IsEmptyCell(engineBoard, predicted))
+		return;
+	int humanSide = engineBoard.sideToMove ^ swapped;
+	MakeMove(engineBoard, predicted);
+	if (GetResult(engineBoard) != RESULT_NONE || engineBoard.moveCount == gridSize * gridSize)
+		return;
+
+	SearchLimits limits = { 0, 0, engineTimeMs, 0, 0 };
+	ponderEntry = PackMove(predicted / gridSize * MAX_GRID_SIZE + predicted % gridSize, humanSide);
+	ponderMoves = sharedMemory->moveCount + 1;
+	ponderSide = engineBoard.sideToMove ^ swapped;
+	ponderSearchId = StartPonder(asyncEngine, engineBoard, limits, PostEngineResult(hwnd));
+}
+
 //  
 void CleanupSharedMemory() {
 	if (sharedMemory) {
@@ -120,6 +361,25 @@ void CleanupSharedMemory() {
 	}
 }
 
+//    stats-<pid>.txt    
+void DumpLatencyStats() {
+	std::string stats = FormatHistogram(readLatency, "propagation read", 1e-3, "us") + "\n" +
+		FormatHistogram(paintLatency, "propagation paint", 1e-3, "us") + "\n" +
+		FormatHistogram(frameLatency, "ui frame while thinking", 1e-3, "us") + "\n";
+
+	PonderStats ponder = ReadPonderStats(asyncEngine);
+	char line[128];
+	snprintf(line, sizeof(line), "ponder hits %llu/%llu (%.1f%%)\n", (unsigned long long)ponder.hits,
+		(unsigned long long)ponder.ponders, ponder.hitRate * 100.0);
+	stats += line;
+
+	std::ofstream file("stats-" + std::to_string(GetCurrentProcessId()) + ".txt");
+	file << stats;
+
+	std::wstring message(stats.begin(), stats.end());
+	MessageBox(NULL, message.c_str(), L"  ", MB_OK | MB_ICONINFORMATION);
+}
+
 //,      
 bool IsPositiveInteger(LPCWSTR str) {
 
@@ -135,6 +395,7 @@ bool IsPositiveInteger(LPCWSTR str) {
 void LoadConfig() {
 	std::ifstream file(configFile);
 	if (!file.is_open()) return;
+	CountMetric(METRIC_CONFIG_RELOADS);
 
 	try
 	{
@@ -172,6 +433,27 @@ void LoadConfig() {
 		}
 		hBrushBackground = CreateSolidBrush(backColor);
 		
+		//  winLength
+		if (config.contains("winLength") && config["winLength"].is_number_integer() && config["winLength"] >= 0 && config["winLength"] <= MAX_GRID_SIZE) {
+			winLength = config["winLength"];
+		}
+
+		//  engine  engineTimeMs
+		if (config.contains("engine") && config["engine"].is_boolean()) {
+			engineEnabled = config["engine"];
+		}
+		if (config.contains("engineTimeMs") && config["engineTimeMs"].is_number_integer() && config["engineTimeMs"] > 0) {
+			engineTimeMs = config["engineTimeMs"];
+		}
+		if (config.contains("enginePonder") && config["enginePonder"].is_boolean()) {
+			enginePonder = config["enginePonder"];
+		}
+
+		//  metricsPort
+		if (config.contains("metricsPort") && config["metricsPort"].is_number_integer() && config["metricsPort"] >= 0 && config["metricsPort"] <= 65535) {
+			metricsPort = config["metricsPort"];
+		}
+
 		//  lineColor
 		if (config.contains("lineColor") && config["lineColor"].is_array() && config["lineColor"].size() == 3) {
 			if (config["lineColor"][0].is_number_integer() &&
@@ -203,7 +485,12 @@ void SaveConfig(HWND hwnd) {
 		{"gridSize", gridSize},
 		{"winSize", { winWidth, winHeight }},
 		{"backColor", { GetRValue(backColor), GetGValue(backColor), GetBValue(backColor) }},
-		{"lineColor", { GetRValue(lineColor), GetGValue(lineColor), GetBValue(lineColor) }}
+		{"lineColor", { GetRValue(lineColor), GetGValue(lineColor), GetBValue(lineColor) }},
+		{"metricsPort", metricsPort},
+		{"winLength", winLength},
+		{"engine", engineEnabled},
+		{"engineTimeMs", engineTimeMs},
+		{"enginePonder", enginePonder}
 	};
 
 	std::ofstream file(configFile);
@@ -216,7 +503,12 @@ void CloseApp(HWND hwnd) {
 	GetWindowRect(hwnd, &winrect);
 
 	SaveConfig(hwnd); // 
+	SaveSession(); // 
+	CancelEngineMove(hwnd);
+	StopAsyncEngine(asyncEngine); //     
+	TRACE_WRITE("trace-" + std::to_string(GetCurrentProcessId()) + ".json"); //,    TTT_TRACE
 	CleanupSharedMemory(); //  
+	StopMetricsServer(metricsServer);
 	PostQuitMessage(0); //
 }
 
@@ -232,6 +524,13 @@ int WINAPI wWinMain(HINSTANCE hInt, HINSTANCE hPrev, PWSTR pCmdLine, int nShow)
 
 	LoadConfig(); //    
 
+	//    ,    
+	if (metricsPort)
+		StartMetricsServer(metricsServer, metricsPort);
+
+	InitEngine(asyncEngine.engine, ENGINE_TABLE_MEGABYTES);
+	StartAsyncEngine(asyncEngine);
+
 	WNDCLASS SoftwareWindClass = { 0 };
 	SoftwareWindClass.hIcon = LoadIcon(NULL, IDI_QUESTION);
 	SoftwareWindClass.hCursor = LoadCursor(NULL, IDC_ARROW);
@@ -270,7 +569,7 @@ int WINAPI wWinMain(HINSTANCE hInt, HINSTANCE hPrev, PWSTR pCmdLine, int nShow)
 
 	HWND hwnd = CreateWindowW(
 		lassName,
-		L"  ",
+		windowTitle,
 		WS_OVERLAPPEDWINDOW | WS_VISIBLE,
 		200, 200, // 
 		baseWindowWidth, baseWindowHeight, // 
@@ -381,6 +680,8 @@ LRESULT CALLBACK WindowProc(HWND hwnd, UINT uMsg, WPARAM wParam, LPARAM lParam)
 	case WM_LBUTTONDOWN:
 	case WM_RBUTTONDOWN:
 	{
+		TRACE_SPAN("Click");
+
 		//  
 		POINT point = { 0 };
 		point.x = LOWORD(lParam);
@@ -394,27 +695,46 @@ LRESULT CALLBACK WindowProc(HWND hwnd, UINT uMsg, WPARAM wParam, LPARAM lParam)
 		if (boardY >= gridSize - 1)
 			boardY = gridSize - 1;
 
-		//   
-		if (sharedMemory) {
-			if (uMsg == WM_LBUTTONDOWN) {
-				sharedMemory->board[boardY][boardX] = 'O';
-			}
-			else {
-				sharedMemory->board[boardY][boardX] = 'X';
-			}
+		PlaceMark(hwnd, boardX, boardY, (uMsg == WM_LBUTTONDOWN) ? SIDE_O : SIDE_X);
+		StartEngineMove(hwnd);
+		return 0;
+	}
+	case WM_ENGINE_DONE:
+	{
+		std::unique_ptr<SearchResult> result((SearchResult*)lParam);
+		if (!engineSearchId || wParam != (WPARAM)engineSearchId)
+			return 0; //  ,    
+
+		TRACE_SPAN("WM_ENGINE_DONE");
+		FinishEngineMove(hwnd);
+		int boardX = result->bestMove % gridSize;
+		int boardY = result->bestMove / gridSize;
+		//   ,      
+		if (result->bestMove >= 0 && sharedMemory && sharedMemory->moveCount == engineSearchMoves && sharedMemory->board[boardY][boardX] == '.') {
+			PlaceMark(hwnd, boardX, boardY, engineSearchSide);
+			StartEnginePonder(hwnd, result->ponderMove);
+		}
+		return 0;
+	}
+	case WM_TIMER:
+	{
+		if (wParam == FRAME_TIMER_ID) {
+			LARGE_INTEGER now;
+			QueryPerformanceCounter(&now);
+			RecordValue(frameLatency, NanosecondsSince(lastFrameTicks));
+			lastFrameTicks = now.QuadPart;
 		}
-
-		//   
-		UpdateBoard(hwnd);
-
-		//     
-		NotifyAllWindows(hwnd);
-
-		InvalidateRect(hwnd, NULL, TRUE);
 		return 0;
 	}
 	case WM_PAINT:
 	{
+		TRACE_SPAN("WM_PAINT");
+		CountMetric(METRIC_PAINTS);
+		if (pendingPaintFlow) {
+			TRACE_FLOW_END("move", pendingPaintFlow);
+			pendingPaintFlow = 0;
+		}
+
 		PAINTSTRUCT ps;
 		HDC hdc = BeginPaint(hwnd, &ps);
 
@@ -438,6 +758,11 @@ LRESULT CALLBACK WindowProc(HWND hwnd, UINT uMsg, WPARAM wParam, LPARAM lParam)
 		}
 
 		EndPaint(hwnd, &ps);
+
+		if (pendingPaintTicks) {
+			RecordValue(paintLatency, NanosecondsSince(pendingPaintTicks));
+			pendingPaintTicks = 0;
+		}
 		return 0;
 	}
 	case WM_KEYDOWN:
@@ -465,11 +790,24 @@ LRESULT CALLBACK WindowProc(HWND hwnd, UINT uMsg, WPARAM wParam, LPARAM lParam)
 			}
 			break;
 		}
+		case 'S': {
+			if ((GetKeyState(VK_SHIFT) & 0x8000)) {
+				DumpLatencyStats();
+			}
+			break;
+		}
+		case 'E': {
+			engineEnabled = !engineEnabled;
+			if (!engineEnabled)
+				CancelEngineMove(hwnd);
+			break;
+		}
 		case VK_RETURN: {
 
 			if (sharedMemory) {
 				sharedMemory->backColor = RGB(rand() % 256, rand() % 256, rand() % 256); //  
 				backColor = sharedMemory->backColor;
+				seenVersion = PublishSharedWrite(*sharedMemory);
 
 				UpdateBackColor(hwnd, backColor);
 
@@ -478,8 +816,8 @@ LRESULT CALLBACK WindowProc(HWND hwnd, UINT uMsg, WPARAM wParam, LPARAM lParam)
 			}
 			break;
 		}
-			return 0;
 		}
+		return 0; //   WM_MOUSEWHEEL    
 	}
 	case WM_MOUSEWHEEL:
 	{
@@ -505,6 +843,7 @@ LRESULT CALLBACK WindowProc(HWND hwnd, UINT uMsg, WPARAM wParam, LPARAM lParam)
 
 			sharedMemory->lineColor = RGB(r, g, b);
 			lineColor = RGB(r, g, b); 
+			seenVersion = PublishSharedWrite(*sharedMemory);
 			NotifyAllWindows(hwnd);
 			InvalidateRect(hwnd, NULL, TRUE); 
 		}
@@ -526,7 +865,20 @@ LRESULT CALLBACK WindowProc(HWND hwnd, UINT uMsg, WPARAM wParam, LPARAM lParam)
 	}
 	default: {
 		if (uMsg == WM_UPDATE_BOARD) {
+			TRACE_SPAN("WM_UPDATE_BOARD");
+			//        WM_PAINT:    
+			if (pendingPaintFlow)
+				TRACE_FLOW_END("move", pendingPaintFlow);
+			if (wParam)
+				TRACE_FLOW_STEP("move", wParam);
+			pendingPaintFlow = wParam;
+
 			UpdateBoard(hwnd);
+			//    : ,    , 
+			if (engineSearchId && sharedMemory && sharedMemory->moveCount != engineSearchMoves)
+				CancelEngineMove(hwnd);
+			else if (ponderSearchId && sharedMemory && sharedMemory->moveCount != ponderMoves - 1)
+				StopPonder();
 			InvalidateRect(hwnd, NULL, TRUE);
 			return 0;
 		}
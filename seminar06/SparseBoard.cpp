@@ -0,0 +1,173 @@
+#include "SparseBoard.h"
+
+const uint64_t FILE_A = 0x0101010101010101ULL; //lx = 0    
+const uint64_t FILE_H = 0x8080808080808080ULL; //lx = 7
+
+static uint64_t ChunkKey(int chunkX, int chunkY) {
+	return ((uint64_t)(uint32_t)chunkX << 32) | (uint32_t)chunkY;
+}
+
+// ,       
+static int ChunkCoord(int coord) {
+	return coord >> SPARSE_CHUNK_BITS;
+}
+
+static int ChunkBit(int x, int y) {
+	return (y & (SPARSE_CHUNK_SIZE - 1)) * SPARSE_CHUNK_SIZE + (x & (SPARSE_CHUNK_SIZE - 1));
+}
+
+//    ,     :   
+static uint64_t ZobristKey(uint32_t cell, int side) {
+	uint64_t z = ((uint64_t)cell * 2 + side) * 0x9E3779B97F4A7C15ULL;
+	z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+	z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+	return z ^ (z >> 31);
+}
+
+void InitBoard(SparseBoard& board, int winLength) {
+	board.winLength = winLength;
+	board.chunks.clear();
+	board.sideToMove = SIDE_X;
+	board.moveCount = 0;
+	board.moves.clear();
+	board.hash = 0;
+}
+
+bool IsEmptyCell(const SparseBoard& board, uint32_t cell) {
+	int x = SparseCellX(cell), y = SparseCellY(cell);
+	auto chunk = board.chunks.find(ChunkKey(ChunkCoord(x), ChunkCoord(y)));
+	if (chunk == board.chunks.end())
+		return true;
+	uint64_t bit = 1ULL << ChunkBit(x, y);
+	return !((chunk->second.stones[SIDE_X] | chunk->second.stones[SIDE_O]) & bit);
+}
+
+//  :    
+void MakeMove(SparseBoard& board, uint32_t cell) {
+	int x = SparseCellX(cell), y = SparseCellY(cell);
+	auto inserted = board.chunks.insert({ ChunkKey(ChunkCoord(x), ChunkCoord(y)), SparseChunk{ { 0, 0 } } });
+	inserted.first->second.stones[board.sideToMove] |= 1ULL << ChunkBit(x, y);
+
+	board.hash ^= ZobristKey(cell, board.sideToMove);
+	board.moves.push_back(cell);
+	board.moveCount++;
+	board.sideToMove ^= 1;
+}
+
+//  ,      
+void UndoMove(SparseBoard& board) {
+	board.sideToMove ^= 1;
+	uint32_t cell = board.moves.back();
+	board.moves.pop_back();
+	board.moveCount--;
+	board.hash ^= ZobristKey(cell, board.sideToMove);
+
+	int x = SparseCellX(cell), y = SparseCellY(cell);
+	auto chunk = board.chunks.find(ChunkKey(ChunkCoord(x), ChunkCoord(y)));
+	chunk->second.stones[board.sideToMove] &= ~(1ULL << ChunkBit(x, y));
+	if ((chunk->second.stones[SIDE_X] | chunk->second.stones[SIDE_O]) == 0)
+		board.chunks.erase(chunk);
+}
+
+//        .
+//         
+static int CountRay(const SparseBoard& board, int x, int y, int dx, int dy, int side, int limit) {
+	int count = 0;
+	uint64_t currentKey = 0;
+	uint64_t stones = 0;
+	bool loaded = false;
+	while (count < limit) {
+		x += dx;
+		y += dy;
+		if (x < -SPARSE_COORD_LIMIT || x > SPARSE_COORD_LIMIT || y < -SPARSE_COORD_LIMIT || y > SPARSE_COORD_LIMIT)
+			break;
+
+		uint64_t key = ChunkKey(ChunkCoord(x), ChunkCoord(y));
+		if (!loaded || key != currentKey) {
+			auto chunk = board.chunks.find(key);
+			stones = chunk == board.chunks.end() ? 0 : chunk->second.stones[side];
+			currentKey = key;
+			loaded = true;
+		}
+		if (!((stones >> ChunkBit(x, y)) & 1))
+			break;
+		count++;
+	}
+	return count;
+}
+
+//      cell   winLength 
+bool IsWinningMove(const SparseBoard& board, uint32_t cell, int side) {
+	static const int directions[4][2] = { { 1, 0 }, { 0, 1 }, { 1, 1 }, { 1, -1 } };
+
+	int x = SparseCellX(cell), y = SparseCellY(cell);
+	int need = board.winLength - 1;
+	for (int i = 0; i < 4; i++) {
+		int dx = directions[i][0], dy = directions[i][1];
+		int forward = CountRay(board, x, y, dx, dy, side, need);
+		if (forward + CountRay(board, x, y, -dx, -dy, side, need - forward) >= need)
+			return true;
+	}
+	return false;
+}
+
+//    :    
+int GetResult(const SparseBoard& board) {
+	if (board.moveCount > 0) {
+		int lastSide = board.sideToMove ^ 1;
+		if (IsWinningMove(board, board.moves[board.moveCount - 1], lastSide))
+			return lastSide == SIDE_X ? RESULT_X_WIN : RESULT_O_WIN;
+	}
+	return RESULT_NONE;
+}
+
+//  ,        (  ),
+//    -  .      
+int GenerateMoves(const SparseBoard& board, std::vector<uint32_t>& moves) {
+	moves.clear();
+	if (board.moveCount == 0) {
+		moves.push_back(SparseCell(0, 0));
+		return 1;
+	}
+
+	std::unordered_map<uint64_t, uint64_t> near;
+	near.reserve(board.chunks.size() * 4);
+	for (const auto& entry : board.chunks) {
+		int chunkX = (int)(int32_t)(entry.first >> 32), chunkY = (int)(int32_t)entry.first;
+		uint64_t stones = entry.second.stones[SIDE_X] | entry.second.stones[SIDE_O];
+
+		//  :    ,        
+		uint64_t row[3];
+		row[0] = (stones & FILE_A) << 7;
+		row[1] = stones | ((stones << 1) & ~FILE_A) | ((stones >> 1) & ~FILE_H);
+		row[2] = (stones & FILE_H) >> 7;
+
+		//        
+		for (int i = 0; i < 3; i++) {
+			if (!row[i])
+				continue;
+			uint64_t mask = row[i];
+			near[ChunkKey(chunkX + i - 1, chunkY - 1)] |= mask << 56;
+			near[ChunkKey(chunkX + i - 1, chunkY)] |= mask | (mask << 8) | (mask >> 8);
+			near[ChunkKey(chunkX + i - 1, chunkY + 1)] |= mask >> 56;
+		}
+	}
+
+	for (const auto& entry : near) {
+		int chunkX = (int)(int32_t)(entry.first >> 32), chunkY = (int)(int32_t)entry.first;
+		uint64_t empty = entry.second;
+		auto chunk = board.chunks.find(entry.first);
+		if (chunk != board.chunks.end())
+			empty &= ~(chunk->second.stones[SIDE_X] | chunk->second.stones[SIDE_O]);
+
+		while (empty) {
+			int bit = LowestBit(empty);
+			empty &= empty - 1;
+			int x = chunkX * SPARSE_CHUNK_SIZE + (bit & (SPARSE_CHUNK_SIZE - 1));
+			int y = chunkY * SPARSE_CHUNK_SIZE + (bit >> SPARSE_CHUNK_BITS);
+			if (x >= -SPARSE_COORD_LIMIT && x <= SPARSE_COORD_LIMIT && y >= -SPARSE_COORD_LIMIT && y <= SPARSE_COORD_LIMIT)
+				moves.push_back(SparseCell(x, y));
+		}
+	}
+	return (int)moves.size();
+}
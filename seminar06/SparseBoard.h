@@ -0,0 +1,47 @@
+#pragma once
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+#include "Board.h"
+
+//    :    8x8,   ,
+//     ,    .    Board
+const int SPARSE_CHUNK_BITS = 3;
+const int SPARSE_CHUNK_SIZE = 1 << SPARSE_CHUNK_BITS;
+const int SPARSE_COORD_LIMIT = 32767; //  -SPARSE_COORD_LIMIT  SPARSE_COORD_LIMIT
+
+// 8x8:  = ly * 8 + lx
+struct SparseChunk {
+	uint64_t stones[2];
+};
+
+struct SparseBoard {
+	int winLength;
+	std::unordered_map<uint64_t, SparseChunk> chunks; // -  
+	int sideToMove;
+	int moveCount;
+	std::vector<uint32_t> moves; //   
+	uint64_t hash;
+};
+
+// -       uint32_t,     Board.
+//,   y + 32768    
+inline uint32_t SparseCell(int x, int y) {
+	return ((uint32_t)(y + 32768) << 16) | (uint32_t)(x + 32768);
+}
+
+inline int SparseCellX(uint32_t cell) {
+	return (int)(cell & 0xFFFF) - 32768;
+}
+
+inline int SparseCellY(uint32_t cell) {
+	return (int)(cell >> 16) - 32768;
+}
+
+void InitBoard(SparseBoard& board, int winLength);
+bool IsEmptyCell(const SparseBoard& board, uint32_t cell);
+void MakeMove(SparseBoard& board, uint32_t cell);
+void UndoMove(SparseBoard& board);
+bool IsWinningMove(const SparseBoard& board, uint32_t cell, int side);
+int GetResult(const SparseBoard& board);
+int GenerateMoves(const SparseBoard& board, std::vector<uint32_t>& moves);
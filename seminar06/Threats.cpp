@@ -0,0 +1,297 @@
+#include "Threats.h"
+#include "WinLines.h"
+
+//  .        
+//       ,      
+struct ThreatSearch {
+	const WinLineView* lines;
+	int attacker;
+	bool useThrees;
+	uint64_t nodes;
+	uint64_t nodeLimit; //    nodes,       
+	const ThreatStopCallback* shouldStop;
+	uint8_t counts[2][MAX_WIN_LINES];
+};
+
+static void PlayThreat(ThreatSearch& search, Board& board, int cell) {
+	const uint16_t* cellLines = search.lines->cellLines + cell * search.lines->perCell;
+	for (int i = 0; i < search.lines->cellLineCount[cell]; i++)
+		search.counts[board.sideToMove][cellLines[i]]++;
+	MakeMove(board, cell);
+}
+
+static void UndoThreat(ThreatSearch& search, Board& board) {
+	UndoMove(board);
+	int cell = board.moves[board.moveCount];
+	const uint16_t* cellLines = search.lines->cellLines + cell * search.lines->perCell;
+	for (int i = 0; i < search.lines->cellLineCount[cell]; i++)
+		search.counts[board.sideToMove][cellLines[i]]--;
+}
+
+//,     own ,   
+static bool IsOpenLine(const ThreatSearch& search, int line, int side, int own) {
+	return search.counts[side][line] == own && search.counts[side ^ 1][line] == 0;
+}
+
+//  .   
+static int EmptyOnLine(const ThreatSearch& search, const Board& board, int line, int* cells) {
+	const uint64_t* mask = search.lines->masks + line * search.lines->words;
+	int count = 0;
+	for (int w = 0; w < search.lines->words; w++) {
+		uint64_t empty = mask[w] & ~(board.stones[SIDE_X].words[w] | board.stones[SIDE_O].words[w]);
+		while (empty) {
+			cells[count++] = w * 64 + LowestBit(empty);
+			empty &= empty - 1;
+		}
+	}
+	return count;
+}
+
+//,     ,  
+static int FindWinningCells(const ThreatSearch& search, const Board& board, int side, int* cells) {
+	bool seen[MAX_CELLS] = { false };
+	int k = board.winLength, count = 0;
+	for (int line = 0; line < search.lines->count; line++) {
+		if (!IsOpenLine(search, line, side, k - 1))
+			continue;
+		int empty[MAX_TABLE_WIN_LENGTH];
+		EmptyOnLine(search, board, line, empty);
+		if (!seen[empty[0]]) {
+			seen[empty[0]] = true;
+			cells[count++] = empty[0];
+		}
+	}
+	return count;
+}
+
+// ,  ,  ,      (gain)
+//      ,   
+static int FindFourMoves(const ThreatSearch& search, const Board& board, int side, int* cells, bool* doubleFour) {
+	int gain[MAX_CELLS];
+	for (int i = 0; i < MAX_CELLS; i++)
+		gain[i] = -1;
+
+	int k = board.winLength, count = 0;
+	for (int line = 0; line < search.lines->count; line++) {
+		if (!IsOpenLine(search, line, side, k - 2))
+			continue;
+		int empty[MAX_TABLE_WIN_LENGTH];
+		EmptyOnLine(search, board, line, empty);
+		for (int i = 0; i < 2; i++) {
+			int cell = empty[i], other = empty[1 - i];
+			if (gain[cell] < 0) {
+				gain[cell] = other;
+				doubleFour[count] = false;
+				cells[count++] = cell;
+			}
+			else if (gain[cell] != other) {
+				for (int j = 0; j < count; j++) {
+					if (cells[j] == cell)
+						doubleFour[j] = true;
+				}
+			}
+		}
+	}
+	return count;
+}
+
+//-  :   ,    k - 3    
+static int FindThreeCandidates(const ThreatSearch& search, const Board& board, int side, int* cells) {
+	bool seen[MAX_CELLS] = { false };
+	int k = board.winLength, count = 0;
+	for (int line = 0; line < search.lines->count; line++) {
+		if (!IsOpenLine(search, line, side, k - 3))
+			continue;
+		int empty[MAX_TABLE_WIN_LENGTH];
+		int emptyCount = EmptyOnLine(search, board, line, empty);
+		for (int i = 0; i < emptyCount; i++) {
+			if (!seen[empty[i]]) {
+				seen[empty[i]] = true;
+				cells[count++] = empty[i];
+			}
+		}
+	}
+	return count;
+}
+
+//  :  ,      ,    .
+//      ,     
+static int FindThreeDefences(const ThreatSearch& search, const Board& board, int* cells) {
+	bool seen[MAX_CELLS] = { false };
+	int k = board.winLength, count = 0;
+	for (int line = 0; line < search.lines->count; line++) {
+		if (!IsOpenLine(search, line, search.attacker, k - 2))
+			continue;
+		int empty[MAX_TABLE_WIN_LENGTH];
+		EmptyOnLine(search, board, line, empty);
+		for (int i = 0; i < 2; i++) {
+			if (!seen[empty[i]]) {
+				seen[empty[i]] = true;
+				cells[count++] = empty[i];
+			}
+		}
+	}
+
+	int fours[MAX_CELLS];
+	bool doubleFour[MAX_CELLS];
+	int fourCount = FindFourMoves(search, board, search.attacker ^ 1, fours, doubleFour);
+	for (int i = 0; i < fourCount; i++) {
+		if (!seen[fours[i]]) {
+			seen[fours[i]] = true;
+			cells[count++] = fours[i];
+		}
+	}
+	return count;
+}
+
+static bool HasDoubleFour(const ThreatSearch& search, const Board& board, int side) {
+	int fours[MAX_CELLS];
+	bool doubleFour[MAX_CELLS];
+	int count = FindFourMoves(search, board, side, fours, doubleFour);
+	for (int i = 0; i < count; i++) {
+		if (doubleFour[i])
+			return true;
+	}
+	return false;
+}
+
+// .       0,    
+static int SearchThreats(ThreatSearch& search, Board& board, int depth, int& bestMove);
+
+//  -,  :      
+static int SearchDefences(ThreatSearch& search, Board& board, int depth, bool three) {
+	int wins[MAX_CELLS];
+	int winCount = FindWinningCells(search, board, search.attacker, wins);
+	if (winCount >= 2)
+		return 2; //   
+
+	int replies[MAX_CELLS];
+	int replyCount;
+	if (winCount == 1) {
+		replies[0] = wins[0];
+		replyCount = 1;
+	}
+	else if (three)
+		replyCount = FindThreeDefences(search, board, replies);
+	else
+		return 0;
+
+	int longest = 0;
+	for (int i = 0; i < replyCount; i++) {
+		PlayThreat(search, board, replies[i]);
+		int move = -1;
+		int plies = SearchThreats(search, board, depth, move);
+		UndoThreat(search, board);
+		if (plies == 0)
+			return 0;
+		if (plies + 1 > longest)
+			longest = plies + 1;
+	}
+	return longest;
+}
+
+static int SearchThreats(ThreatSearch& search, Board& board, int depth, int& bestMove) {
+	search.nodes++;
+	if ((search.nodes & (THREAT_STOP_CHECK_INTERVAL - 1)) == 0 && *search.shouldStop && (*search.shouldStop)())
+		search.nodeLimit = search.nodes;
+	int attacker = search.attacker;
+
+	int wins[MAX_CELLS];
+	if (FindWinningCells(search, board, attacker, wins) > 0) {
+		bestMove = wins[0];
+		return 1;
+	}
+	if (depth == 0 || search.nodes >= search.nodeLimit || board.moveCount + 2 >= board.size * board.size)
+		return 0;
+
+	//    ,  ,   
+	int defenderWins[MAX_CELLS];
+	int defenderWinCount = FindWinningCells(search, board, attacker ^ 1, defenderWins);
+	if (defenderWinCount >= 2)
+		return 0;
+
+	int fours[MAX_CELLS];
+	bool doubleFour[MAX_CELLS];
+	int fourCount = FindFourMoves(search, board, attacker, fours, doubleFour);
+
+	//   ,     
+	for (int i = 0; i < fourCount; i++) {
+		if (doubleFour[i] && (defenderWinCount == 0 || fours[i] == defenderWins[0])) {
+			bestMove = fours[i];
+			return 3;
+		}
+	}
+
+	for (int i = 0; i < fourCount; i++) {
+		if (defenderWinCount == 1 && fours[i] != defenderWins[0])
+			continue;
+		PlayThreat(search, board, fours[i]);
+		int plies = SearchDefences(search, board, depth - 1, false);
+		UndoThreat(search, board);
+		if (plies > 0) {
+			bestMove = fours[i];
+			return plies + 1;
+		}
+	}
+
+	//     ,          
+	if (!search.useThrees || defenderWinCount > 0 || depth < 2)
+		return 0;
+
+	int threes[MAX_CELLS];
+	int threeCount = FindThreeCandidates(search, board, attacker, threes);
+	for (int i = 0; i < threeCount; i++) {
+		PlayThreat(search, board, threes[i]);
+		int plies = 0;
+		if (HasDoubleFour(search, board, attacker))
+			plies = SearchDefences(search, board, depth - 1, true);
+		UndoThreat(search, board);
+		if (plies > 0) {
+			bestMove = threes[i];
+			return plies + 1;
+		}
+		if (search.nodes >= search.nodeLimit)
+			break;
+	}
+	return 0;
+}
+
+ThreatSearchResult FindThreatWin(const Board& rootBoard, int maxDepth, uint64_t nodeLimit, bool useThrees,
+	const ThreatStopCallback& shouldStop) {
+	ThreatSearchResult result = { false, -1, 0, 0 };
+	ThreatSearch search;
+	search.lines = GetWinLines(rootBoard.size, rootBoard.winLength);
+	if (!search.lines || GetResult(rootBoard) != RESULT_NONE)
+		return result;
+
+	search.attacker = rootBoard.sideToMove;
+	search.useThrees = false;
+	search.nodes = 0;
+	search.nodeLimit = nodeLimit ? nodeLimit : UINT64_MAX;
+	search.shouldStop = &shouldStop;
+
+	for (int line = 0; line < search.lines->count; line++) {
+		const uint64_t* mask = search.lines->masks + line * search.lines->words;
+		int counts[2] = { 0, 0 };
+		for (int w = 0; w < search.lines->words; w++) {
+			counts[SIDE_X] += PopCount(mask[w] & rootBoard.stones[SIDE_X].words[w]);
+			counts[SIDE_O] += PopCount(mask[w] & rootBoard.stones[SIDE_O].words[w]);
+		}
+		search.counts[SIDE_X][line] = (uint8_t)counts[SIDE_X];
+		search.counts[SIDE_O][line] = (uint8_t)counts[SIDE_O];
+	}
+
+	//   :      ,   
+	Board board = rootBoard;
+	int move = -1;
+	int plies = SearchThreats(search, board, maxDepth, move);
+	if (plies == 0 && useThrees && search.nodes < search.nodeLimit) {
+		search.useThrees = true;
+		plies = SearchThreats(search, board, maxDepth, move);
+	}
+	result.win = plies > 0;
+	result.move = result.win ? move : -1;
+	result.plies = plies;
+	result.nodes = search.nodes;
+	return result;
+}
@@ -0,0 +1,23 @@
+#pragma once
+#include <cstdint>
+#include <functional>
+#include "Board.h"
+
+//   :      ,  -    .
+// -   k ,     ,  - ,  
+//      .   k  3  5 (. WinLines.h)
+struct ThreatSearchResult {
+	bool win; //   ,  
+	int move; //  
+	int plies; //     
+	uint64_t nodes;
+};
+
+const uint64_t THREAT_STOP_CHECK_INTERVAL = 64; //   (   ),  
+
+//true -  .     ,     
+typedef std::function<bool()> ThreatStopCallback;
+
+//maxDepth -    , useThrees -    
+ThreatSearchResult FindThreatWin(const Board& board, int maxDepth, uint64_t nodeLimit, bool useThrees,
+	const ThreatStopCallback& shouldStop = ThreatStopCallback());
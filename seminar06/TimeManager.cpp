@@ -0,0 +1,26 @@
+#include <algorithm>
+#include "TimeManager.h"
+
+TimeBudget AllocateTime(const TimeControl& clock, const Board& board) {
+	TimeBudget budget = { 1, 1 };
+	int available = clock.remainingMs - TIME_OVERHEAD_MS;
+	if (available <= 1)
+		return budget;
+
+	int empty = board.size * board.size - board.moveCount;
+	int movesLeft = clock.movesToGo > 0 ? clock.movesToGo : std::min(std::max((empty + 1) / 2, 1), TIME_MAX_MOVES);
+	double soft = (double)available / movesLeft + clock.incrementMs * TIME_INCREMENT_SHARE;
+	if (board.moveCount < TIME_OPENING_PLIES)
+		soft *= TIME_OPENING_SHARE;
+
+	//       ,     
+	double hardLimit = movesLeft == 1 ? available : available * TIME_HARD_SHARE;
+	budget.hardMs = std::max((int)std::min(soft * TIME_HARD_FACTOR, hardLimit), 1);
+	budget.softMs = std::max(std::min((int)soft, budget.hardMs), 1);
+	return budget;
+}
+
+void ApplyTimeBudget(SearchLimits& limits, const TimeBudget& budget) {
+	limits.timeMs = budget.hardMs;
+	limits.softTimeMs = budget.softMs;
+}
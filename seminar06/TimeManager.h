@@ -0,0 +1,29 @@
+#pragma once
+#include "Board.h"
+#include "Engine.h"
+
+//    .   -       ,
+// -     .         
+//(   ),        ,       TIME_OVERHEAD_MS
+const int TIME_OVERHEAD_MS = 10;
+const int TIME_MAX_MOVES = 40; //     :       
+const int TIME_OPENING_PLIES = 4; //  ,    
+const double TIME_OPENING_SHARE = 0.5;
+const double TIME_INCREMENT_SHARE = 0.75; //    
+const double TIME_HARD_FACTOR = 4.0; //Ƹ      ,
+const double TIME_HARD_SHARE = 0.5; //     
+
+struct TimeControl {
+	int remainingMs; //   
+	int incrementMs; //   
+	int movesToGo; //   , 0 -    
+};
+
+struct TimeBudget {
+	int softMs;
+	int hardMs;
+};
+
+//      :   ,    TIME_MAX_MOVES
+TimeBudget AllocateTime(const TimeControl& clock, const Board& board);
+void ApplyTimeBudget(SearchLimits& limits, const TimeBudget& budget);
@@ -0,0 +1,119 @@
+#include "Trace.h"
+#ifdef TTT_TRACE
+#include <Windows.h>
+#include <atomic>
+#include <cstdio>
+
+const int TRACE_BUFFER_EVENTS = 1 << 16; //  ,  
+const int MAX_TRACE_THREADS = 64;
+
+//    .    count, 
+//WriteTrace        
+struct TraceBuffer {
+	DWORD threadId;
+	std::atomic<int> count;
+	std::atomic<uint64_t> dropped;
+	TraceEvent events[TRACE_BUFFER_EVENTS];
+};
+
+//      ,        
+static std::atomic<TraceBuffer*> traceBuffers[MAX_TRACE_THREADS];
+static std::atomic<int> traceBufferCount(0);
+static std::atomic<uint64_t> traceFlowCounter(0);
+static thread_local TraceBuffer* threadBuffer = NULL;
+
+static TraceBuffer* GetThreadBuffer() {
+	if (threadBuffer)
+		return threadBuffer;
+
+	int slot = traceBufferCount++;
+	if (slot >= MAX_TRACE_THREADS)
+		return NULL;
+
+	TraceBuffer* buffer = new TraceBuffer;
+	buffer->threadId = GetCurrentThreadId();
+	buffer->count.store(0, std::memory_order_relaxed);
+	buffer->dropped.store(0, std::memory_order_relaxed);
+	traceBuffers[slot].store(buffer, std::memory_order_release);
+	threadBuffer = buffer;
+	return buffer;
+}
+
+uint64_t TraceTicks() {
+	LARGE_INTEGER counter;
+	QueryPerformanceCounter(&counter);
+	return (uint64_t)counter.QuadPart;
+}
+
+void TraceRecord(const char* name, char phase, uint64_t start, uint64_t duration, uint64_t flow) {
+	TraceBuffer* buffer = GetThreadBuffer();
+	if (!buffer)
+		return;
+
+	int index = buffer->count.load(std::memory_order_relaxed);
+	if (index == TRACE_BUFFER_EVENTS) {
+		buffer->dropped.fetch_add(1, std::memory_order_relaxed);
+		return;
+	}
+
+	TraceEvent& event = buffer->events[index];
+	event.name = name;
+	event.phase = phase;
+	event.start = start;
+	event.duration = duration;
+	event.flow = flow;
+	buffer->count.store(index + 1, std::memory_order_release);
+}
+
+// ,   :     .
+//  WPARAM,   32-    32 
+uint64_t TraceNewFlow() {
+	uint64_t id = (++traceFlowCounter * 0x9E3779B97F4A7C15ULL) ^ ((uint64_t)GetCurrentProcessId() << 20);
+	return (uint64_t)(uintptr_t)id;
+}
+
+// ,      
+bool WriteTrace(const std::string& path) {
+	FILE* file = NULL;
+	if (fopen_s(&file, path.c_str(), "w") != 0)
+		return false;
+
+	LARGE_INTEGER frequency;
+	QueryPerformanceFrequency(&frequency);
+	double ticksToMicroseconds = 1e6 / (double)frequency.QuadPart;
+	DWORD pid = GetCurrentProcessId();
+
+	fprintf(file, "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n");
+	fprintf(file, "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":%lu,\"tid\":0,\"args\":{\"name\":\"tic tac toe %lu\"}}",
+		(unsigned long)pid, (unsigned long)pid);
+
+	int buffers = traceBufferCount.load();
+	if (buffers > MAX_TRACE_THREADS)
+		buffers = MAX_TRACE_THREADS;
+	for (int i = 0; i < buffers; i++) {
+		TraceBuffer* buffer = traceBuffers[i].load(std::memory_order_acquire);
+		if (!buffer)
+			continue;
+
+		int count = buffer->count.load(std::memory_order_acquire);
+		for (int j = 0; j < count; j++) {
+			const TraceEvent& event = buffer->events[j];
+			fprintf(file, ",\n{\"name\":\"%s\",\"cat\":\"ttt\",\"ph\":\"%c\",\"ts\":%.3f,\"pid\":%lu,\"tid\":%lu",
+				event.name, event.phase, event.start * ticksToMicroseconds, (unsigned long)pid, (unsigned long)buffer->threadId);
+			if (event.phase == 'X')
+				fprintf(file, ",\"dur\":%.3f}", event.duration * ticksToMicroseconds);
+			else
+				fprintf(file, ",\"id\":\"0x%llx\"%s}", (unsigned long long)event.flow, event.phase == 'f' ? ",\"bp\":\"e\"" : "");
+		}
+
+		uint64_t dropped = buffer->dropped.load();
+		if (dropped)
+			fprintf(file, ",\n{\"name\":\"dropped %llu events\",\"ph\":\"i\",\"s\":\"t\",\"ts\":0,\"pid\":%lu,\"tid\":%lu}",
+				(unsigned long long)dropped, (unsigned long)pid, (unsigned long)buffer->threadId);
+	}
+
+	fprintf(file, "\n]}\n");
+	return fclose(file) == 0;
+}
+
+#endif
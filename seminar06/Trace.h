@@ -0,0 +1,52 @@
+#pragma once
+#include <cstdint>
+#include <string>
+
+//     Chrome trace event (chrome://tracing, ui.perfetto.dev).
+//    TTT_TRACE (/D TTT_TRACE),         .
+//   QueryPerformanceCounter,     ,  
+//    (console trace-merge)           
+#ifdef TTT_TRACE
+
+//   .     
+struct TraceEvent {
+	const char* name;
+	char phase; //'X' - , 's'/'t'/'f' - ,      
+	uint64_t start; // QueryPerformanceCounter
+	uint64_t duration;
+	uint64_t flow; //   's'/'t'/'f'
+};
+
+uint64_t TraceTicks();
+void TraceRecord(const char* name, char phase, uint64_t start, uint64_t duration, uint64_t flow);
+uint64_t TraceNewFlow();
+bool WriteTrace(const std::string& path);
+
+//      
+struct TraceSpan {
+	const char* name;
+	uint64_t start;
+
+	explicit TraceSpan(const char* spanName) : name(spanName), start(TraceTicks()) {}
+	~TraceSpan() { TraceRecord(name, 'X', start, TraceTicks() - start, 0); }
+};
+
+#define TRACE_CONCAT_INNER(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_INNER(a, b)
+#define TRACE_SPAN(name) TraceSpan TRACE_CONCAT(traceSpan, __LINE__)(name)
+#define TRACE_NEW_FLOW() TraceNewFlow()
+#define TRACE_FLOW_START(name, flow) TraceRecord(name, 's', TraceTicks(), 0, flow)
+#define TRACE_FLOW_STEP(name, flow) TraceRecord(name, 't', TraceTicks(), 0, flow)
+#define TRACE_FLOW_END(name, flow) TraceRecord(name, 'f', TraceTicks(), 0, flow)
+#define TRACE_WRITE(path) WriteTrace(path)
+
+#else
+
+#define TRACE_SPAN(name) ((void)0)
+#define TRACE_NEW_FLOW() ((uint64_t)0)
+#define TRACE_FLOW_START(name, flow) ((void)0)
+#define TRACE_FLOW_STEP(name, flow) ((void)0)
+#define TRACE_FLOW_END(name, flow) ((void)0)
+#define TRACE_WRITE(path) ((void)0)
+
+#endif
@@ -0,0 +1,169 @@
+#include <cstdio>
+#include "TrainingData.h"
+
+std::string ShardPath(const std::string& directory, int number) {
+	char name[32];
+	snprintf(name, sizeof(name), "shard-%05d.bin", number);
+	return directory.empty() ? name : directory + "\\" + name;
+}
+
+static bool WriteBytes(HANDLE hFile, const void* data, size_t size) {
+	DWORD written = 0;
+	return WriteFile(hFile, data, (DWORD)size, &written, NULL) && written == size;
+}
+
+static bool StartShard(ShardWriter& writer) {
+	writer.hShard = CreateFileA(ShardPath(writer.directory, writer.shardCount).c_str(), GENERIC_WRITE, FILE_SHARE_READ, NULL,
+		CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, NULL);
+	if (writer.hShard == INVALID_HANDLE_VALUE)
+		return false;
+
+	ShardHeader header = { SHARD_MAGIC, SHARD_VERSION, writer.gridSize, writer.winLength };
+	writer.shardCount++;
+	writer.shardWritten = sizeof(header);
+	writer.totalBytes += sizeof(header);
+	return WriteBytes(writer.hShard, &header, sizeof(header));
+}
+
+static void WriterThread(ShardWriter* writer) {
+	std::unique_lock<std::mutex> lock(writer->mutex);
+	for (;;) {
+		writer->queued.wait(lock, [writer]() { return !writer->queue.empty() || writer->closing; });
+		if (writer->queue.empty())
+			break;
+		std::vector<uint8_t> buffer = std::move(writer->queue.front());
+		writer->queue.pop_front();
+		writer->drained.notify_all();
+		lock.unlock();
+
+		//   :      
+		bool ok = true;
+		if (writer->hShard == INVALID_HANDLE_VALUE || writer->shardWritten >= writer->shardBytes) {
+			if (writer->hShard != INVALID_HANDLE_VALUE)
+				CloseHandle(writer->hShard);
+			ok = StartShard(*writer);
+		}
+		ok = ok && WriteBytes(writer->hShard, buffer.data(), buffer.size());
+		writer->shardWritten += buffer.size();
+		writer->totalBytes += buffer.size();
+
+		lock.lock();
+		if (!ok)
+			writer->failed = true;
+	}
+}
+
+bool OpenShardWriter(ShardWriter& writer, const std::string& directory, int gridSize, int winLength, uint64_t shardBytes) {
+	if (!directory.empty() && !CreateDirectoryA(directory.c_str(), NULL) && GetLastError() != ERROR_ALREADY_EXISTS)
+		return false;
+
+	writer.directory = directory;
+	writer.gridSize = gridSize;
+	writer.winLength = winLength;
+	writer.shardBytes = shardBytes;
+	writer.queue.clear();
+	writer.closing = false;
+	writer.failed = false;
+	writer.hShard = INVALID_HANDLE_VALUE;
+	writer.shardWritten = 0;
+	writer.shardCount = 0;
+	writer.totalBytes = 0;
+	writer.thread = std::thread(WriterThread, &writer);
+	return true;
+}
+
+static void PutUint16(std::vector<uint8_t>& buffer, int value) {
+	buffer.push_back((uint8_t)value);
+	buffer.push_back((uint8_t)(value >> 8));
+}
+
+static int GetUint16(const uint8_t* pos) {
+	return pos[0] | (pos[1] << 8);
+}
+
+void EncodeSample(std::vector<uint8_t>& buffer, const TrainingSample& sample) {
+	const Board& board = sample.board;
+	buffer.push_back((uint8_t)board.sideToMove);
+	buffer.push_back((uint8_t)sample.result);
+	PutUint16(buffer, (uint16_t)(int16_t)sample.score);
+	PutUint16(buffer, board.moveCount);
+	buffer.push_back((uint8_t)sample.policyCount);
+
+	int cells = board.size * board.size;
+	for (int side = 0; side < 2; side++) {
+		for (int cell = 0; cell < cells; cell += 8) {
+			uint8_t bits = 0;
+			for (int i = 0; i < 8 && cell + i < cells; i++)
+				bits |= (uint8_t)(TestBit(board.stones[side], cell + i) << i);
+			buffer.push_back(bits);
+		}
+	}
+
+	for (int i = 0; i < sample.policyCount; i++) {
+		PutUint16(buffer, sample.policy[i].cell);
+		PutUint16(buffer, sample.policy[i].visits);
+	}
+}
+
+void SubmitShardBuffer(ShardWriter& writer, std::vector<uint8_t>& buffer) {
+	if (buffer.empty())
+		return;
+	std::unique_lock<std::mutex> lock(writer.mutex);
+	writer.drained.wait(lock, [&writer]() { return writer.queue.size() < SHARD_QUEUE_LIMIT; });
+	writer.queue.push_back(std::move(buffer));
+	buffer.clear();
+	writer.queued.notify_one();
+}
+
+bool CloseShardWriter(ShardWriter& writer) {
+	{
+		std::lock_guard<std::mutex> lock(writer.mutex);
+		writer.closing = true;
+		writer.queued.notify_one();
+	}
+	writer.thread.join();
+	if (writer.hShard != INVALID_HANDLE_VALUE) {
+		CloseHandle(writer.hShard);
+		writer.hShard = INVALID_HANDLE_VALUE;
+	}
+	return !writer.failed;
+}
+
+bool DecodeSample(const uint8_t*& pos, const uint8_t* end, const ShardHeader& header, TrainingSample& sample) {
+	int cells = header.gridSize * header.gridSize;
+	int planeBytes = (cells + 7) / 8;
+	const int fixedBytes = 7;
+	if (end - pos < fixedBytes + 2 * planeBytes)
+		return false;
+
+	int side = pos[0];
+	sample.result = pos[1];
+	sample.score = (int16_t)GetUint16(pos + 2);
+	int moveCount = GetUint16(pos + 4);
+	sample.policyCount = pos[6];
+	if (side > SIDE_O || sample.result > 2 || moveCount > cells || end - pos < fixedBytes + 2 * planeBytes + 4 * sample.policyCount)
+		return false;
+	pos += fixedBytes;
+
+	//      ,     
+	Board& board = sample.board;
+	InitBoard(board, header.gridSize, header.winLength);
+	for (int s = 0; s < 2; s++) {
+		for (int cell = 0; cell < cells; cell++) {
+			if ((pos[cell >> 3] >> (cell & 7)) & 1)
+				SetBit(board.stones[s], cell);
+		}
+		pos += planeBytes;
+	}
+	board.sideToMove = side;
+	board.moveCount = moveCount;
+
+	for (int i = 0; i < sample.policyCount; i++) {
+		sample.policy[i].cell = (uint16_t)GetUint16(pos);
+		sample.policy[i].visits = (uint16_t)GetUint16(pos + 2);
+		pos += 4;
+		if (sample.policy[i].cell >= cells)
+			return false;
+	}
+	return true;
+}
@@ -0,0 +1,72 @@
+#pragma once
+#include <Windows.h>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "Board.h"
+
+//    - (shard): ,   .
+//:   (1 ),    (1 : 0 - , 1 - , 2 - ),
+//  (int16),   (uint16),    (1 ),
+// X  O   (cells + 7) / 8 ,   ( uint16,  uint16)
+const uint32_t SHARD_MAGIC = 0x44545454; //"TTTD",    SNAPSHOT_MAGIC
+const uint32_t SHARD_VERSION = 1;
+const int SHARD_MAX_POLICY = 255;
+const size_t SHARD_QUEUE_LIMIT = 8; //   ,   
+
+struct ShardHeader {
+	uint32_t magic;
+	uint32_t version;
+	int32_t gridSize;
+	int32_t winLength;
+};
+
+struct PolicyEntry {
+	uint16_t cell;
+	uint16_t visits;
+};
+
+// .  -   ; -    
+struct TrainingSample {
+	Board board;
+	int score; //    
+	int result; //0 - , 1 - , 2 -   
+	int policyCount;
+	PolicyEntry policy[SHARD_MAX_POLICY];
+};
+
+//   :          ,
+//    ,      
+struct ShardWriter {
+	std::string directory;
+	int gridSize;
+	int winLength;
+	uint64_t shardBytes; //  ,       
+
+	std::mutex mutex;
+	std::condition_variable queued; //    
+	std::condition_variable drained; //   
+	std::deque<std::vector<uint8_t>> queue;
+	bool closing;
+	bool failed;
+	std::thread thread;
+
+	//   
+	HANDLE hShard;
+	uint64_t shardWritten;
+	int shardCount;
+	uint64_t totalBytes;
+};
+
+bool OpenShardWriter(ShardWriter& writer, const std::string& directory, int gridSize, int winLength, uint64_t shardBytes);
+void EncodeSample(std::vector<uint8_t>& buffer, const TrainingSample& sample);
+//   ; buffer  . ,   
+void SubmitShardBuffer(ShardWriter& writer, std::vector<uint8_t>& buffer);
+bool CloseShardWriter(ShardWriter& writer);
+
+std::string ShardPath(const std::string& directory, int number);
+//    , pos   
+bool DecodeSample(const uint8_t*& pos, const uint8_t* end, const ShardHeader& header, TrainingSample& sample);
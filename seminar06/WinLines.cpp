@@ -0,0 +1,72 @@
+#include <utility>
+#include "WinLines.h"
+
+const int TABLE_WIN_LENGTHS = MAX_TABLE_WIN_LENGTH - MIN_TABLE_WIN_LENGTH + 1;
+
+template <int SIZE, int K>
+static void AddWinLine(WinLineTable<SIZE, K>& table, int index, int x, int y, int dx, int dy) {
+	for (int i = 0; i < K; i++) {
+		int cell = (y + i * dy) * SIZE + x + i * dx;
+		table.masks[index][cell >> 6] |= 1ULL << (cell & 63);
+		table.cellLines[cell][table.cellLineCount[cell]++] = (uint16_t)index;
+	}
+}
+
+template <int SIZE, int K>
+static void FillWinLineTable() {
+	WinLineTable<SIZE, K>& table = WinLines<SIZE, K>::table;
+	int index = 0;
+	for (int y = 0; y < SIZE; y++) {
+		for (int x = 0; x + K <= SIZE; x++)
+			AddWinLine(table, index++, x, y, 1, 0);
+	}
+	for (int y = 0; y + K <= SIZE; y++) {
+		for (int x = 0; x < SIZE; x++)
+			AddWinLine(table, index++, x, y, 0, 1);
+	}
+	for (int y = 0; y + K <= SIZE; y++) {
+		for (int x = 0; x + K <= SIZE; x++) {
+			AddWinLine(table, index++, x, y, 1, 1);
+			AddWinLine(table, index++, x, y + K - 1, 1, -1);
+		}
+	}
+}
+
+template <size_t... SIZES>
+static void FillWinLineTables(std::index_sequence<SIZES...>) {
+	int fill[] = { (FillWinLineTable<SIZES + 3, 3>(), FillWinLineTable<SIZES + 3, 4>(), FillWinLineTable<SIZES + 3, 5>(), 0)... };
+	(void)fill;
+}
+
+static struct WinLinesInit {
+	WinLinesInit() {
+		FillWinLineTables(std::make_index_sequence<MAX_GRID_SIZE - 2>());
+	}
+} winLinesInit;
+
+template <int SIZE, int K>
+constexpr WinLineView MakeWinLineView() {
+	typedef WinLineTable<SIZE, K> Table;
+	return { Table::COUNT, Table::WORDS, Table::PER_CELL,
+		&WinLines<SIZE, K>::table.masks[0][0], &WinLines<SIZE, K>::table.cellLines[0][0], WinLines<SIZE, K>::table.cellLineCount };
+}
+
+// -   k   ,     3
+struct WinLineViews {
+	WinLineView bySize[MAX_GRID_SIZE - 2][TABLE_WIN_LENGTHS];
+};
+
+template <size_t... SIZES>
+constexpr WinLineViews MakeWinLineViews(std::index_sequence<SIZES...>) {
+	return { { { MakeWinLineView<SIZES + 3, 3>(), MakeWinLineView<SIZES + 3, 4>(), MakeWinLineView<SIZES + 3, 5>() }... } };
+}
+
+static_assert(TABLE_WIN_LENGTHS == 3, "MakeWinLineViews  k = 3, 4, 5");
+static constexpr WinLineViews winLineViews = MakeWinLineViews(std::make_index_sequence<MAX_GRID_SIZE - 2>());
+
+const WinLineView* GetWinLines(int size, int winLength) {
+	if (size < 3 || size > MAX_GRID_SIZE || winLength < MIN_TABLE_WIN_LENGTH || winLength > MAX_TABLE_WIN_LENGTH)
+		return NULL;
+	const WinLineView& view = winLineViews.bySize[size - 3][winLength - MIN_TABLE_WIN_LENGTH];
+	return view.count > 0 ? &view : NULL;
+}
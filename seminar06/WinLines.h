@@ -0,0 +1,45 @@
+#pragma once
+#include <cstdint>
+#include "Board.h"
+
+//    SIZE x SIZE  K .
+// -    ,        
+const int MIN_TABLE_WIN_LENGTH = 3;
+const int MAX_TABLE_WIN_LENGTH = 5; //  k   
+const int MAX_WIN_LINES = 2 * MAX_GRID_SIZE * (MAX_GRID_SIZE - 2) + 2 * (MAX_GRID_SIZE - 2) * (MAX_GRID_SIZE - 2); //    k = 3
+
+template <int SIZE, int K>
+struct WinLineTable {
+	static const int CELLS = SIZE * SIZE;
+	static const int WORDS = (CELLS + 63) / 64;
+	static const int SPAN = K <= SIZE ? SIZE - K + 1 : 0; //      
+	static const int COUNT = 2 * SIZE * SPAN + 2 * SPAN * SPAN;
+	static const int PER_CELL = 4 * K; //      
+
+	uint64_t masks[COUNT > 0 ? COUNT : 1][WORDS];
+	uint16_t cellLines[CELLS][PER_CELL];
+	uint8_t cellLineCount[CELLS];
+};
+
+//     (WinLines.cpp),     .  
+//  :        constexpr,   MSVC
+template <int SIZE, int K>
+struct WinLines {
+	static WinLineTable<SIZE, K> table;
+};
+
+template <int SIZE, int K>
+WinLineTable<SIZE, K> WinLines<SIZE, K>::table;
+
+//    ,  ,       
+struct WinLineView {
+	int count;
+	int words; //    
+	int perCell;
+	const uint64_t* masks; //masks[line * words + word]
+	const uint16_t* cellLines; //cellLines[cell * perCell + i]
+	const uint8_t* cellLineCount;
+};
+
+//NULL,      k  
+const WinLineView* GetWinLines(int size, int winLength);